@@ -0,0 +1,249 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Benchmark ROM: drives the render, update and input paths through synthetic
+ * PomodoroContext states and reports min, median and max CPU cycles per call
+ * on screen and to the log. Build it with POMI_IWRAM=0 and 1 to compare the
+ * ROM/Thumb and IWRAM/ARM placements of the hot path.
+ */
+#include <algorithm>
+#include <cstdint>
+
+#include "bn_core.h"
+#include "bn_log.h"
+#include "bn_timer.h"
+#include "bn_timers.h"
+#include "bn_string.h"
+#include "bn_bg_palettes.h"
+
+#include "common_info.h"
+#include "common_variable_8x16_sprite_font.h"
+
+#include "pomodoro.h"
+#include "psg_audio.h"
+#include "timer_screen.h"
+
+namespace {
+    constexpr int ITERATIONS = 2048;
+    
+    // bn::timer ticks are 64 CPU cycles long, which bounds the timing resolution
+    constexpr int CYCLES_PER_TICK = 16777216 / bn::timers::ticks_per_second();
+    
+    uint16_t samples[ITERATIONS];
+    
+    struct Result {
+        bn::string_view name;
+        int min;
+        int median;
+        int max;
+    };
+    
+    // Time run(i) for each iteration, after an untimed setup(i)
+    template<typename Setup, typename Run>
+    Result measure(const bn::string_view& name, Setup&& setup, Run&& run) {
+        bn::timer timer;
+        
+        for (int i = 0; i < ITERATIONS; ++i) {
+            setup(i);
+            
+            int start = timer.elapsed_ticks();
+            run(i);
+            samples[i] = static_cast<uint16_t>(timer.elapsed_ticks() - start);
+        }
+        
+        std::sort(samples, samples + ITERATIONS);
+        
+        Result result = { name, samples[0] * CYCLES_PER_TICK, samples[ITERATIONS / 2] * CYCLES_PER_TICK,
+                          samples[ITERATIONS - 1] * CYCLES_PER_TICK };
+        BN_LOG(name, " cycles min: ", result.min, " median: ", result.median, " max: ", result.max);
+        
+        // Let the engine commit the sprites and maps built by this path
+        bn::core::update();
+        return result;
+    }
+    
+    constexpr bn::string_view placementName(bool iwram) {
+        return iwram ? "IWRAM" : "ROM";
+    }
+    
+    // Synthetic running timer state for the given iteration
+    void setupTimerState(PomodoroContext& ctx, int iteration) {
+        constexpr PomodoroState states[] = {
+            PomodoroState::WORK, PomodoroState::SHORT_BREAK, PomodoroState::LONG_BREAK
+        };
+        
+        ctx.state = states[(iteration / 256) % 3];
+        ctx.secondsRemaining = stateDuration(ctx) - iteration % stateDuration(ctx);
+        ctx.timerActive = (iteration / 64) % 2;
+        ctx.completedSessions = iteration / 128;
+    }
+    
+    void writeResult(BgText& bgText, int row, const Result& result) {
+        bn::string<32> line = result.name;
+        
+        while (line.size() < 10) {
+            line.append(' ');
+        }
+        
+        for (int value : { result.min, result.median, result.max }) {
+            bn::string<8> valueText = bn::to_string<8>(value);
+            
+            for (int padding = valueText.size(); padding < 6; ++padding) {
+                line.append(' ');
+            }
+            
+            line.append(valueText);
+        }
+        
+        bgText.write(0, row, line);
+    }
+}
+
+int main()
+{
+    bn::core::init();
+    
+    // Same sound setup as the ROM, so paths that play a chime write to a live PSG
+    initAudio();
+    
+    bn::sprite_text_generator text_generator(common::variable_8x16_sprite_font);
+    text_generator.set_center_alignment();
+    bn::bg_palettes::set_transparent_color(bn::color(0, 0, 8));
+    
+    PomodoroContext ctx;
+    ctx.state = PomodoroState::WORK;
+    ctx.secondsRemaining = ctx.config.workTime;
+    
+    BgText bgText;
+    StateTheme theme(common::variable_8x16_sprite_font.item().palette_item(), stateColor(ctx));
+    SpritePool spritePool;
+    PomodoroScreen pomodoroScreen(text_generator, theme, spritePool);
+    ConfigScreen configScreen;
+    TextLabel timerLabel(spritePool, 0, 0);
+    
+    bgText.writeCentered(BgText::rowAt(0), "RUNNING BENCHMARKS...");
+    bgText.commit();
+    bn::core::update();
+    
+    BN_LOG("Placement core: ", placementName(POMI_IWRAM_CORE), " text: ", placementName(POMI_IWRAM_TEXT));
+    
+    Result results[9];
+    int resultsCount = 0;
+    
+    results[resultsCount++] = measure("POMODORO", [&](int i) {
+        setupTimerState(ctx, i);
+    }, [&](int) {
+        renderPomodoro(ctx, bgText, pomodoroScreen);
+        pomodoroScreen.refresh(text_generator);
+    });
+    
+    pomodoroScreen.release();
+    
+    results[resultsCount++] = measure("CONFIG", [&](int i) {
+        ctx.configSelection = i % 4;
+        ctx.config.workTime = (25 + (i / 4) % 8) * 60;
+    }, [&](int) {
+        renderConfig(ctx, bgText, configScreen);
+    });
+    
+    configScreen.release();
+    ctx.config = PomodoroConfig();
+    
+    ProgressBar progressBar(5, BgText::rowAt(35), 20);
+    
+    results[resultsCount++] = measure("TIMER SCR", [&](int i) {
+        setupTimerState(ctx, i);
+    }, [&](int) {
+        renderTimer(ctx, bgText, text_generator, timerLabel, progressBar);
+    });
+    
+    progressBar.show(bgText);
+    
+    results[resultsCount++] = measure("PROGRESS", [&](int i) {
+        setupTimerState(ctx, i);
+    }, [&](int) {
+        drawProgressBar(bgText, progressBar, stateDuration(ctx) - ctx.secondsRemaining, stateDuration(ctx));
+    });
+    
+    results[resultsCount++] = measure("TIMER TXT", [&](int i) {
+        ctx.secondsRemaining = ITERATIONS - i;
+    }, [&](int) {
+        renderTimerText(text_generator, timerLabel, ctx.secondsRemaining);
+    });
+    
+    timerLabel.release();
+    progressBar.hide();
+    
+    // Glyph and tilemap writers: one full text row and a cell run
+    results[resultsCount++] = measure("BG WRITE", [&](int) {
+    }, [&](int i) {
+        int row = i % BG_TEXT_ROWS;
+        bgText.write(0, row, "Start:A Reset:B Config:SELECT");
+        bgText.fill(1, row, BG_TEXT_COLUMNS - 2, ' ');
+    });
+    
+    // Steady state frame: timer running, no second boundary crossed
+    results[resultsCount++] = measure("UPD IDLE", [&](int i) {
+        setupTimerState(ctx, i);
+        ctx.timerActive = true;
+        ctx.timebase.start(ctx.timer.elapsed_ticks());
+    }, [&](int) {
+        updateTimer(ctx);
+    });
+    
+    // Second boundary, every other one finishing the interval
+    results[resultsCount++] = measure("UPD TICK", [&](int i) {
+        setupTimerState(ctx, i);
+        ctx.timerActive = true;
+        ctx.secondsRemaining = i % 2 ? 1 : 100;
+        ctx.timebase.reset(ctx.timer.elapsed_ticks() - bn::timers::ticks_per_second());
+    }, [&](int) {
+        updateTimer(ctx);
+    });
+    
+    // Key dispatch: config menu adjustments and navigation, every other
+    // iteration a timer toggle
+    InputEvents inputEvents;
+    
+    results[resultsCount++] = measure("INPUT", [&](int i) {
+        constexpr uint16_t configKeys[] = {
+            KeyInput::RIGHT, KeyInput::LEFT | KeyInput::DOWN, KeyInput::RIGHT | KeyInput::UP, KeyInput::LEFT
+        };
+        
+        KeyInput keys;
+        
+        if (i % 2) {
+            ctx.state = PomodoroState::CONFIG;
+            keys.pressed = configKeys[(i / 2) % 4];
+        } else {
+            setupTimerState(ctx, i);
+            keys.pressed = KeyInput::A;
+        }
+        
+        inputEvents.fill(keys);
+    }, [&](int) {
+        handleInput(ctx, inputEvents);
+    });
+    
+    ctx.config = PomodoroConfig();
+    
+    bgText.clear();
+    bgText.write(0, 0, "CPU CYCLES PER CALL");
+    
+    bn::string<32> placementText = "CORE:";
+    placementText.append(placementName(POMI_IWRAM_CORE));
+    placementText.append(" TEXT:");
+    placementText.append(placementName(POMI_IWRAM_TEXT));
+    bgText.write(0, 1, placementText);
+    bgText.write(0, 3, "PATH         MIN   MED   MAX");
+    
+    for (int index = 0; index < resultsCount; ++index) {
+        writeResult(bgText, 5 + index, results[index]);
+    }
+    
+    bgText.commit();
+    
+    while(true)
+    {
+        bn::core::update();
+    }
+}
@@ -0,0 +1,64 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Full-redraw timer screen implementation
+ */
+#include "timer_screen.h"
+
+namespace {
+    // Build a simple panel header, e.g. "[ STATUS ]"
+    bn::string<32> panelHeader(const bn::string_view& title) {
+        bn::string<32> header = "[ ";
+        header.append(title);
+        header.append(" ]");
+        return header;
+    }
+
+    // Write a panel's title at the top center of where the panel would be
+    void drawPanel(BgText& bgText, int x, int y, int height, const bn::string_view& title) {
+        bgText.writeCentered(BgText::columnAt(x), BgText::rowAt(panelHeaderY(y, height)), panelHeader(title));
+    }
+}
+
+void drawProgressBar(BgText& bgText, ProgressBar& bar, int current, int total) {
+    // Calculate progress (0-100%)
+    int progress = total > 0 ? (current * 100) / total : 0;
+
+    // The bar itself is a window edge over a prebuilt glyph row
+    bar.setProgress(current, 0, total);
+
+    // Draw percentage
+    bn::string<16> percentText = bn::to_string<8>(progress);
+    percentText.append("%");
+    bgText.writeCentered(BgText::rowAt(30), percentText);
+}
+
+void renderTimerText(bn::sprite_text_generator& text_generator, TextLabel& timerLabel, long long seconds) {
+    // Rewrite the label's pooled sprites, centered on screen
+    timerLabel.setPosition(0, 0);
+    timerLabel.setText(formatClock(int(seconds)));
+    timerLabel.refresh(text_generator);
+}
+
+void renderTimer(PomodoroContext& ctx, BgText& bgText, bn::sprite_text_generator& text_generator,
+                 TextLabel& timerLabel, ProgressBar& progressBar) {
+    // Dynamically choose start/pause text based on timer state
+    bn::string_view controls_text = ctx.timerActive ? "PAUSE:A  RESET:B  MENU:SELECT" :
+                                                      "START:A  RESET:B  MENU:SELECT";
+
+    bgText.clear();
+    bgText.writeCentered(BgText::rowAt(-70), "MISSION TIMER");
+
+    drawPanel(bgText, 0, -30, 50, "TIME");
+    renderTimerText(text_generator, timerLabel, ctx.secondsRemaining);
+
+    drawPanel(bgText, 0, 25, 40, "PROGRESS");
+
+    int totalTime = stateDuration(ctx);
+    progressBar.show(bgText);
+    drawProgressBar(bgText, progressBar, totalTime - ctx.secondsRemaining, totalTime);
+
+    drawPanel(bgText, 0, 75, 30, "COMMAND");
+
+    // Draw controls on a single map row
+    bgText.writeCentered(BgText::rowAt(75), controls_text);
+}
@@ -0,0 +1,24 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Full-redraw "MISSION TIMER" screen, the baseline the benchmark compares the
+ * retained PomodoroScreen against. Every call clears the BG text layer and
+ * writes all of it again.
+ */
+#ifndef POMI_TIMER_SCREEN_H
+#define POMI_TIMER_SCREEN_H
+
+#include "bn_sprite_text_generator.h"
+
+#include "pomodoro.h"
+
+// Redraw the whole timer screen
+void renderTimer(PomodoroContext& ctx, BgText& bgText, bn::sprite_text_generator& text_generator,
+                 TextLabel& timerLabel, ProgressBar& progressBar);
+
+// Set the bar and write its percentage below it
+void drawProgressBar(BgText& bgText, ProgressBar& bar, int current, int total);
+
+// Rewrite the countdown label as MM:SS, centered on screen
+void renderTimerText(bn::sprite_text_generator& text_generator, TextLabel& timerLabel, long long seconds);
+
+#endif
@@ -0,0 +1,26 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Host stand-in for bn::color: the core only stores colors in its config.
+ */
+#ifndef POMI_HOST_BN_COLOR_H
+#define POMI_HOST_BN_COLOR_H
+
+namespace bn {
+    class color {
+    public:
+        constexpr color() = default;
+
+        constexpr color(int red, int green, int blue) :
+            _data(red | (green << 5) | (blue << 10)) {
+        }
+
+        [[nodiscard]] constexpr int data() const {
+            return _data;
+        }
+
+    private:
+        int _data = 0;
+    };
+}
+
+#endif
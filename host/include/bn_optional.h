@@ -0,0 +1,15 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Host stand-in for bn::optional.
+ */
+#ifndef POMI_HOST_BN_OPTIONAL_H
+#define POMI_HOST_BN_OPTIONAL_H
+
+#include <optional>
+
+namespace bn {
+    template<typename Type>
+    using optional = std::optional<Type>;
+}
+
+#endif
@@ -0,0 +1,40 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Host SRAM: a 32KB byte image with the bn::sram offset accessors, so the
+ * save block and history ring are written in their cartridge format.
+ */
+#ifndef POMI_HOST_BN_SRAM_H
+#define POMI_HOST_BN_SRAM_H
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace bn::sram {
+    constexpr int HOST_SIZE = 32 * 1024;
+
+    // Cartridge SRAM contents, erased to 0xFF like a blank cart by the simulation
+    inline uint8_t hostImage[HOST_SIZE];
+
+    inline int hostWrites = 0;
+
+    template<typename Type>
+    void read_offset(Type& destination, int offset) {
+        static_assert(std::is_trivially_copyable_v<Type>);
+        assert(offset >= 0 && offset + int(sizeof(Type)) <= HOST_SIZE);
+
+        std::memcpy(&destination, hostImage + offset, sizeof(Type));
+    }
+
+    template<typename Type>
+    void write_offset(const Type& source, int offset) {
+        static_assert(std::is_trivially_copyable_v<Type>);
+        assert(offset >= 0 && offset + int(sizeof(Type)) <= HOST_SIZE);
+
+        std::memcpy(hostImage + offset, &source, sizeof(Type));
+        ++hostWrites;
+    }
+}
+
+#endif
@@ -0,0 +1,14 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Host stand-in for bn::string_view, used by the state labels.
+ */
+#ifndef POMI_HOST_BN_STRING_VIEW_H
+#define POMI_HOST_BN_STRING_VIEW_H
+
+#include <string_view>
+
+namespace bn {
+    using string_view = std::string_view;
+}
+
+#endif
@@ -0,0 +1,437 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Headless simulation of the timer core.
+ *
+ * A scripted user works through months of pomodoro intervals at the tick
+ * level, with random pauses, resets and power cycles. Every step is checked
+ * against values derived independently of the core:
+ *
+ *  - session and set counting, and the state each finished interval leads to
+ *  - session clock and countdown drift against the simulated tick count
+ *  - the SRAM save block and history ring, reloaded at each power cycle
+ *  - held direction auto-repeat and acceleration in the config menu
+ *  - A in standby starting a full work interval
+ *
+ * Usage: pomi_host [days] [step ticks] [seed]
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "bn_sram.h"
+
+#include "pomodoro_core.h"
+#include "save_store.h"
+#include "session_history.h"
+#include "reminders.h"
+
+namespace {
+    int soundsPlayed = 0;
+    int failures = 0;
+
+    constexpr int MAX_REPORTED_FAILURES = 20;
+
+    void check(bool condition, const char* what, uint64_t simulatedSeconds) {
+        if (condition) {
+            return;
+        }
+
+        if (failures < MAX_REPORTED_FAILURES) {
+            std::printf("FAIL at %llu s: %s\n", static_cast<unsigned long long>(simulatedSeconds), what);
+        }
+
+        ++failures;
+    }
+
+    // xorshift32, deterministic for a given seed
+    class Random {
+    public:
+        explicit Random(uint32_t seed) :
+            _state(seed ? seed : 1) {
+        }
+
+        uint32_t next() {
+            _state ^= _state << 13;
+            _state ^= _state >> 17;
+            _state ^= _state << 5;
+            return _state;
+        }
+
+        // True with a probability of one in the given number of calls
+        bool oneIn(uint32_t calls) {
+            return next() % calls == 0;
+        }
+
+        uint32_t range(uint32_t min, uint32_t max) {
+            return min + next() % (max - min + 1);
+        }
+
+    private:
+        uint32_t _state;
+    };
+
+    // Everything that is lost at power off
+    struct Console {
+        PomodoroContext ctx;
+        InputEvents events;
+        SaveStore saveStore;
+        SessionHistory history;
+
+        // Same sequence as main()
+        void boot() {
+            ctx.state = PomodoroState::WORK;
+            saveStore.load(ctx);
+            ctx.secondsRemaining = stateDuration(ctx);
+            history.load(ctx);
+            saveStore.resume(ctx);
+            armReminders(ctx);
+        }
+    };
+
+    bool sameRecord(const SessionRecord& a, const SessionRecord& b) {
+        return a.state == b.state && a.startTime == b.startTime && a.plannedSeconds == b.plannedSeconds &&
+               a.actualSeconds == b.actualSeconds && a.paused == b.paused && a.reset == b.reset;
+    }
+
+    // Hold RIGHT on the work time from its default, checking each frame's
+    // value against the repeat timing and the accelerated steps
+    void checkConfigRepeat() {
+        PomodoroContext ctx;
+        InputEvents events;
+        changeState(ctx, PomodoroState::CONFIG);
+
+        int expected = ctx.config.workTime / 60;
+        int repeats = 0;
+
+        for (int frame = 0; frame < 200; ++frame) {
+            KeyInput keys;
+            keys.pressed = frame == 0 ? KeyInput::RIGHT : 0;
+            keys.held = KeyInput::RIGHT;
+            events.fill(keys);
+            bool input = handleInput(ctx, events);
+
+            bool due = frame == 0 || (frame >= POMI_REPEAT_DELAY_FRAMES &&
+                                      (frame - POMI_REPEAT_DELAY_FRAMES) % POMI_REPEAT_RATE_FRAMES == 0);
+
+            if (due) {
+                if (frame && ++repeats > POMI_REPEAT_ACCEL_REPEATS) {
+                    expected += POMI_REPEAT_ACCEL_STEP - expected % POMI_REPEAT_ACCEL_STEP;
+                } else {
+                    ++expected;
+                }
+
+                expected = expected > MAX_CONFIG_MINUTES ? MAX_CONFIG_MINUTES : expected;
+            }
+
+            check(input == due, "auto-repeat timing", 0);
+            check(ctx.config.workTime == expected * 60, "auto-repeat steps", 0);
+        }
+
+        check(ctx.config.workTime == MAX_CONFIG_MINUTES * 60, "held direction reaches the maximum", 0);
+
+        // A release stops the repeat
+        KeyInput released;
+        events.fill(released);
+        check(!handleInput(ctx, events), "repeat stops on release", 0);
+    }
+
+    // Leave the config menu for standby and press A: a work interval starts
+    // with the full, newly configured duration
+    void checkStandbyStart() {
+        PomodoroContext ctx;
+        InputEvents events;
+        changeState(ctx, PomodoroState::CONFIG);
+        ctx.config.workTime = 10 * 60;
+
+        auto press = [&ctx, &events](uint16_t key) {
+            KeyInput keys;
+            keys.pressed = key;
+            events.fill(keys);
+            handleInput(ctx, events);
+        };
+
+        press(KeyInput::B);
+        check(ctx.state == PomodoroState::IDLE && !ctx.timerActive, "leaving the config menu stands by", 0);
+
+        press(KeyInput::A);
+        check(ctx.state == PomodoroState::WORK, "A in standby starts a work interval", 0);
+        check(ctx.timerActive && ctx.sessionStarted, "standby start runs the timer", 0);
+        check(ctx.secondsRemaining == ctx.config.workTime, "standby start has the full work duration", 0);
+
+        // One second later the countdown has started from the full duration
+        ctx.timer.advance(TICKS_PER_SECOND);
+        updateTimer(ctx);
+        check(ctx.secondsRemaining == ctx.config.workTime - 1, "standby start counts down", 0);
+    }
+
+    class Simulation {
+    public:
+        Simulation(unsigned stepTicks, uint32_t seed) :
+            _stepTicks(stepTicks),
+            _random(seed) {
+            std::memset(bn::sram::hostImage, 0xFF, sizeof(bn::sram::hostImage));
+            powerOn();
+        }
+
+        void run(uint64_t seconds) {
+            uint64_t endTicks = seconds * TICKS_PER_SECOND;
+
+            while (_totalTicks < endTicks) {
+                step();
+            }
+
+            powerCycle();
+        }
+
+        void report(double wallSeconds) const {
+            double simulatedSeconds = double(_totalTicks) / TICKS_PER_SECOND;
+            std::printf("simulated:  %.1f days (%.0f s) in %llu steps of %u ticks\n",
+                        simulatedSeconds / SECONDS_PER_DAY, simulatedSeconds,
+                        static_cast<unsigned long long>(_steps), _stepTicks);
+            std::printf("intervals:  %zu finished, %d work sessions, %d sets, %d pauses, %d resets\n",
+                        _records.size(), _expectedSessions, _expectedSets, _pauses, _resets);
+            std::printf("history:    %d records in %d bytes\n", _console->history.count(),
+                        _console->history.usedBytes());
+            std::printf("platform:   %d power cycles, %d SRAM writes, %d sounds, %d reminders\n",
+                        _boots - 1, bn::sram::hostWrites, soundsPlayed, _reminders);
+            std::printf("speed:      %.0f simulated seconds per second (%.3f s)\n",
+                        wallSeconds > 0 ? simulatedSeconds / wallSeconds : 0, wallSeconds);
+        }
+
+    private:
+        unsigned _stepTicks;
+        Random _random;
+        std::unique_ptr<Console> _console;
+
+        uint64_t _totalTicks = 0;
+        uint64_t _bootTicks = 0;        // Ticks since the last power on
+        uint32_t _bootClock = 0;        // Session clock right after the last power on
+        uint64_t _steps = 0;
+        int _boots = 0;
+
+        // Scripted user: seconds left before pressing A while the timer is stopped
+        uint64_t _waitTicks = 0;
+
+        // Countdown check of an interval running since its start without a pause
+        bool _tracking = false;
+        uint64_t _trackStartTicks = 0;
+        int _trackDuration = 0;
+
+        std::vector<SessionRecord> _records;
+        std::vector<bool> _sameBoot;    // Record started and ended without a power cycle in between
+        uint32_t _sessionBoot = 0;      // Boot number when the open interval started
+        int _expectedSessions = 0;
+        int _expectedSets = 0;
+        int _pauses = 0;
+        int _resets = 0;
+        int _reminders = 0;
+
+        uint64_t now() const {
+            return _totalTicks / TICKS_PER_SECOND;
+        }
+
+        void powerOn() {
+            _console = std::make_unique<Console>();
+            _console->boot();
+            ++_boots;
+
+            _bootTicks = 0;
+            _bootClock = _console->ctx.clockSeconds;
+            _tracking = false;
+            _waitTicks = TICKS_PER_SECOND * _random.range(1, 30);
+        }
+
+        // Power off between two frames and check what comes back from SRAM
+        void powerCycle() {
+            Console before = *_console;
+            powerOn();
+
+            const PomodoroContext& ctx = _console->ctx;
+            uint64_t second = now();
+            check(ctx.completedSessions == before.ctx.completedSessions, "completed sessions restored", second);
+            check(ctx.completedSets == before.ctx.completedSets, "completed sets restored", second);
+            check(std::memcmp(&ctx.stats, &before.ctx.stats, sizeof(SessionStats)) == 0, "statistics restored",
+                  second);
+            check(ctx.state == before.ctx.state, "state restored", second);
+            check(ctx.sessionStarted == before.ctx.sessionStarted, "open interval restored", second);
+            check(ctx.secondsRemaining >= before.ctx.secondsRemaining, "remaining time not lost", second);
+            check(!before.ctx.timerActive || ctx.secondsRemaining - before.ctx.secondsRemaining <=
+                  int(SAVE_CHECKPOINT_SECONDS) + 1, "running interval checkpointed", second);
+            check(ctx.clockSeconds + SAVE_CHECKPOINT_SECONDS + 1 >= before.ctx.clockSeconds ||
+                  !before.ctx.timerActive, "session clock resumed", second);
+            check(_console->history.count() == before.history.count(), "history count restored", second);
+            check(_console->history.usedBytes() == before.history.usedBytes(), "history size restored", second);
+
+            // Every record kept in the ring decodes to what the core finished
+            int index = int(_records.size()) - _console->history.count();
+            bool decoded = index >= 0;
+
+            _console->history.forEach([&](const SessionRecord& record) {
+                decoded = decoded && sameRecord(record, _records[index++]);
+            });
+
+            check(decoded, "history records decoded", second);
+        }
+
+        KeyInput scriptedKeys() {
+            const PomodoroContext& ctx = _console->ctx;
+            KeyInput keys;
+
+            if (!ctx.timerActive) {
+                if (_waitTicks > _stepTicks) {
+                    _waitTicks -= _stepTicks;
+                } else {
+                    keys.pressed = KeyInput::A;
+                }
+            } else if (_random.oneIn(40000)) {
+                keys.pressed = KeyInput::B;
+                _waitTicks = TICKS_PER_SECOND * _random.range(5, 60);
+                ++_resets;
+            } else if (_random.oneIn(6000)) {
+                keys.pressed = KeyInput::A;
+                _waitTicks = TICKS_PER_SECOND * _random.range(10, 600);
+                ++_pauses;
+            }
+
+            return keys;
+        }
+
+        // A finished interval, checked against the counting rules
+        void observe(const SessionRecord& record) {
+            const PomodoroContext& ctx = _console->ctx;
+            uint64_t second = now();
+            _records.push_back(record);
+            _sameBoot.push_back(_sessionBoot == uint32_t(_boots));
+
+            if (!record.reset) {
+                if (record.state == PomodoroState::WORK) {
+                    ++_expectedSessions;
+                    bool setDone = _expectedSessions % ctx.config.sessionsPerSet == 0;
+                    _expectedSets += setDone;
+                    check(ctx.state == (setDone ? PomodoroState::LONG_BREAK : PomodoroState::SHORT_BREAK),
+                          "break follows work", second);
+                } else {
+                    check(ctx.state == PomodoroState::WORK, "work follows a break", second);
+                }
+
+                check(ctx.secondsRemaining == stateDuration(ctx), "next interval starts full", second);
+                check(record.focusSeconds == record.plannedSeconds, "completed interval fully timed", second);
+
+                // The start is stamped with the session clock of the previous step and
+                // the end is seen on the first step after the last second
+                int slack = int(2 * uint64_t(_stepTicks) / TICKS_PER_SECOND) + 2;
+                check(!_sameBoot.back() || record.paused ||
+                      (record.actualSeconds >= record.plannedSeconds &&
+                       record.actualSeconds <= record.plannedSeconds + slack), "interval length", second);
+            }
+
+            check(ctx.completedSessions == _expectedSessions, "session count", second);
+            check(ctx.completedSets == _expectedSets, "set count", second);
+            check(!ctx.timerActive, "timer stops at the end of an interval", second);
+
+            _tracking = false;
+            _waitTicks = TICKS_PER_SECOND * _random.range(5, 120);
+        }
+
+        void step() {
+            Console& console = *_console;
+            PomodoroContext& ctx = console.ctx;
+
+            // Time passes during the frame, then the main loop runs
+            ctx.timer.advance(_stepTicks);
+            _totalTicks += _stepTicks;
+            _bootTicks += _stepTicks;
+            ++_steps;
+
+            bool wasActive = ctx.timerActive;
+            bool wasStarted = ctx.sessionStarted;
+            console.events.fill(scriptedKeys());
+            bool input = handleInput(ctx, console.events);
+
+            if (!wasStarted && ctx.sessionStarted) {
+                _sessionBoot = uint32_t(_boots);
+            }
+
+            // Only intervals started from their full duration are tracked
+            if (!wasActive && ctx.timerActive && ctx.secondsRemaining == stateDuration(ctx) &&
+                    ctx.timebase.remainderTicks() == 0) {
+                _tracking = true;
+                _trackStartTicks = _bootTicks;
+                _trackDuration = ctx.secondsRemaining;
+            } else if (wasActive != ctx.timerActive) {
+                _tracking = false;
+            }
+
+            updateTimer(ctx);
+
+            if (ctx.finishedSession) {
+                observe(*ctx.finishedSession);
+            }
+
+            console.history.update(ctx);
+            console.saveStore.update(ctx, input);
+
+            DeadlineId due;
+
+            while (ctx.deadlines.popDue(ctx.clockSeconds, due)) {
+                fireReminder(ctx, due);
+                _reminders += due != DeadlineId::ALERT_CLEAR;
+            }
+
+            // Drift: the session clock and the countdown are exact tick divisions
+            uint64_t second = now();
+            check(ctx.clockSeconds - _bootClock == _bootTicks / TICKS_PER_SECOND, "session clock drift", second);
+
+            if (_tracking) {
+                int elapsed = int((_bootTicks - _trackStartTicks) / TICKS_PER_SECOND);
+                check(ctx.secondsRemaining == _trackDuration - elapsed, "countdown drift", second);
+            }
+
+            // Power cuts every few days on average
+            if (_random.oneIn(uint32_t(uint64_t(3) * SECONDS_PER_DAY * TICKS_PER_SECOND / _stepTicks))) {
+                powerCycle();
+            }
+        }
+    };
+}
+
+void playSound(SoundId sound) {
+    soundsPlayed += sound != SoundId::NONE;
+}
+
+void playSound(int, int) {
+    ++soundsPlayed;
+}
+
+int main(int argc, char** argv) {
+    int days = argc > 1 ? std::atoi(argv[1]) : 120;
+    unsigned stepTicks = argc > 2 ? unsigned(std::strtoul(argv[2], nullptr, 10)) : TICKS_PER_SECOND / 4 + 3;
+    uint32_t seed = argc > 3 ? uint32_t(std::strtoul(argv[3], nullptr, 10)) : 2025;
+
+    if (days <= 0 || stepTicks == 0) {
+        std::printf("Usage: %s [days] [step ticks] [seed]\n", argv[0]);
+        return 2;
+    }
+
+    checkConfigRepeat();
+    checkStandbyStart();
+
+    Simulation simulation(stepTicks, seed);
+
+    auto start = std::chrono::steady_clock::now();
+    simulation.run(uint64_t(days) * SECONDS_PER_DAY);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    simulation.report(elapsed.count());
+
+    if (failures) {
+        std::printf("%d checks failed\n", failures);
+        return 1;
+    }
+
+    std::printf("all checks passed\n");
+    return 0;
+}
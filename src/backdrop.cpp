@@ -0,0 +1,63 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Gradient backdrop implementation
+ */
+#include "backdrop.h"
+
+#include "bn_span.h"
+#include "bn_display.h"
+
+namespace {
+    constexpr int SCANLINES = bn::display::height();
+
+    struct Gradient {
+        bn::color colors[SCANLINES];
+    };
+
+    constexpr int lerpChannel(int top, int bottom, int line) {
+        return top + ((bottom - top) * line + (SCANLINES - 1) / 2) / (SCANLINES - 1);
+    }
+
+    // Linear from the top to the bottom scanline
+    constexpr Gradient gradient(bn::color top, bn::color bottom) {
+        Gradient result = {};
+
+        for (int line = 0; line < SCANLINES; ++line) {
+            result.colors[line] = bn::color(lerpChannel(top.red(), bottom.red(), line),
+                                            lerpChannel(top.green(), bottom.green(), line),
+                                            lerpChannel(top.blue(), bottom.blue(), line));
+        }
+
+        return result;
+    }
+
+    // Indexed by PomodoroState. Dark enough for white text, tinted like the state accent
+    constexpr Gradient GRADIENTS[] = {
+        gradient(bn::color(0, 0, 8), bn::color(0, 0, 2)),      // IDLE
+        gradient(bn::color(9, 0, 2), bn::color(1, 0, 1)),      // WORK
+        gradient(bn::color(0, 8, 3), bn::color(0, 1, 1)),      // SHORT_BREAK
+        gradient(bn::color(1, 3, 11), bn::color(0, 0, 2)),     // LONG_BREAK
+        gradient(bn::color(0, 6, 8), bn::color(0, 1, 2)),      // CONFIG
+        gradient(bn::color(6, 6, 0), bn::color(1, 1, 0))       // STATS
+    };
+
+    static_assert(sizeof(GRADIENTS) / sizeof(GRADIENTS[0]) == POMODORO_STATES, "Missing state gradients");
+
+    bn::span<const bn::color> gradientColors(PomodoroState state) {
+        return GRADIENTS[static_cast<int>(state)].colors;
+    }
+}
+
+Backdrop::Backdrop(PomodoroState state) :
+    _hbe(bn::bg_palettes_transparent_color_hbe_ptr::create(gradientColors(state))),
+    _state(state) {
+}
+
+void Backdrop::setState(PomodoroState state) {
+    if (state == _state) {
+        return;
+    }
+
+    _state = state;
+    _hbe.set_colors_ref(gradientColors(state));
+}
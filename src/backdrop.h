@@ -0,0 +1,30 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Per-state gradient backdrops.
+ *
+ * Each state has a vertical gradient, one backdrop color per scanline,
+ * computed at compile time into ROM tables. An H-Blank effect (an HDMA
+ * transfer set up by bn::bg_palettes_transparent_color_hbe_ptr) writes the
+ * next color before each scanline, so the backdrop costs no CPU per frame and
+ * a state change only swaps the table pointer.
+ */
+#ifndef POMI_BACKDROP_H
+#define POMI_BACKDROP_H
+
+#include "bn_bg_palettes_transparent_color_hbe_ptr.h"
+
+#include "pomodoro_core.h"
+
+class Backdrop {
+public:
+    explicit Backdrop(PomodoroState state);
+
+    // Show the gradient of a state, nothing is written if it is already shown
+    void setState(PomodoroState state);
+
+private:
+    bn::bg_palettes_transparent_color_hbe_ptr _hbe;
+    PomodoroState _state;
+};
+
+#endif
@@ -0,0 +1,130 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * 8x8 font for the background text layer.
+ *
+ * Uppercase ASCII from ' ' to '_', the CP437 arrows (0x18-0x1B), a solid
+ * block (0x7F), '|' and chart bars one to eight rows high (0x01-0x08).
+ * Lowercase letters are drawn with the uppercase glyphs.
+ * Each glyph is 8 rows of 8 pixels, bit n of a row being pixel n from the left.
+ */
+#ifndef POMI_BG_FONT_H
+#define POMI_BG_FONT_H
+
+#include <cstdint>
+
+constexpr int BG_FONT_GLYPHS = 78;
+
+// Chart bar heights, character n is a bar n rows high touching the bottom of the cell
+constexpr int BG_FONT_BAR_LEVELS = 8;
+
+constexpr uint8_t BG_FONT_ROWS[BG_FONT_GLYPHS][8] = {
+        { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },  // ' '
+        { 0x08, 0x08, 0x08, 0x08, 0x08, 0x00, 0x08, 0x00 },  // '!'
+        { 0x14, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },  // '"'
+        { 0x14, 0x14, 0x3E, 0x14, 0x3E, 0x14, 0x14, 0x00 },  // '#'
+        { 0x08, 0x3C, 0x0A, 0x1C, 0x28, 0x1E, 0x08, 0x00 },  // '$'
+        { 0x06, 0x26, 0x10, 0x08, 0x04, 0x32, 0x30, 0x00 },  // '%'
+        { 0x0C, 0x12, 0x0A, 0x04, 0x2A, 0x12, 0x2C, 0x00 },  // '&'
+        { 0x08, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },  // "'"
+        { 0x10, 0x08, 0x04, 0x04, 0x04, 0x08, 0x10, 0x00 },  // '('
+        { 0x04, 0x08, 0x10, 0x10, 0x10, 0x08, 0x04, 0x00 },  // ')'
+        { 0x00, 0x08, 0x2A, 0x1C, 0x2A, 0x08, 0x00, 0x00 },  // '*'
+        { 0x00, 0x08, 0x08, 0x3E, 0x08, 0x08, 0x00, 0x00 },  // '+'
+        { 0x00, 0x00, 0x00, 0x00, 0x0C, 0x08, 0x04, 0x00 },  // ','
+        { 0x00, 0x00, 0x00, 0x3E, 0x00, 0x00, 0x00, 0x00 },  // '-'
+        { 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0x00 },  // '.'
+        { 0x00, 0x20, 0x10, 0x08, 0x04, 0x02, 0x00, 0x00 },  // '/'
+        { 0x1C, 0x22, 0x32, 0x2A, 0x26, 0x22, 0x1C, 0x00 },  // '0'
+        { 0x08, 0x0C, 0x08, 0x08, 0x08, 0x08, 0x1C, 0x00 },  // '1'
+        { 0x1C, 0x22, 0x20, 0x10, 0x08, 0x04, 0x3E, 0x00 },  // '2'
+        { 0x3E, 0x10, 0x08, 0x10, 0x20, 0x22, 0x1C, 0x00 },  // '3'
+        { 0x10, 0x18, 0x14, 0x12, 0x3E, 0x10, 0x10, 0x00 },  // '4'
+        { 0x3E, 0x02, 0x1E, 0x20, 0x20, 0x22, 0x1C, 0x00 },  // '5'
+        { 0x18, 0x04, 0x02, 0x1E, 0x22, 0x22, 0x1C, 0x00 },  // '6'
+        { 0x3E, 0x20, 0x10, 0x08, 0x04, 0x04, 0x04, 0x00 },  // '7'
+        { 0x1C, 0x22, 0x22, 0x1C, 0x22, 0x22, 0x1C, 0x00 },  // '8'
+        { 0x1C, 0x22, 0x22, 0x3C, 0x20, 0x10, 0x0C, 0x00 },  // '9'
+        { 0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00, 0x00 },  // ':'
+        { 0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x08, 0x04, 0x00 },  // ';'
+        { 0x10, 0x08, 0x04, 0x02, 0x04, 0x08, 0x10, 0x00 },  // '<'
+        { 0x00, 0x00, 0x3E, 0x00, 0x3E, 0x00, 0x00, 0x00 },  // '='
+        { 0x04, 0x08, 0x10, 0x20, 0x10, 0x08, 0x04, 0x00 },  // '>'
+        { 0x1C, 0x22, 0x20, 0x10, 0x08, 0x00, 0x08, 0x00 },  // '?'
+        { 0x1C, 0x22, 0x20, 0x2C, 0x2A, 0x2A, 0x1C, 0x00 },  // '@'
+        { 0x1C, 0x22, 0x22, 0x3E, 0x22, 0x22, 0x22, 0x00 },  // 'A'
+        { 0x1E, 0x22, 0x22, 0x1E, 0x22, 0x22, 0x1E, 0x00 },  // 'B'
+        { 0x1C, 0x22, 0x02, 0x02, 0x02, 0x22, 0x1C, 0x00 },  // 'C'
+        { 0x0E, 0x12, 0x22, 0x22, 0x22, 0x12, 0x0E, 0x00 },  // 'D'
+        { 0x3E, 0x02, 0x02, 0x1E, 0x02, 0x02, 0x3E, 0x00 },  // 'E'
+        { 0x3E, 0x02, 0x02, 0x1E, 0x02, 0x02, 0x02, 0x00 },  // 'F'
+        { 0x1C, 0x22, 0x02, 0x3A, 0x22, 0x22, 0x3C, 0x00 },  // 'G'
+        { 0x22, 0x22, 0x22, 0x3E, 0x22, 0x22, 0x22, 0x00 },  // 'H'
+        { 0x1C, 0x08, 0x08, 0x08, 0x08, 0x08, 0x1C, 0x00 },  // 'I'
+        { 0x38, 0x10, 0x10, 0x10, 0x10, 0x12, 0x0C, 0x00 },  // 'J'
+        { 0x22, 0x12, 0x0A, 0x06, 0x0A, 0x12, 0x22, 0x00 },  // 'K'
+        { 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x3E, 0x00 },  // 'L'
+        { 0x22, 0x36, 0x2A, 0x2A, 0x22, 0x22, 0x22, 0x00 },  // 'M'
+        { 0x22, 0x22, 0x26, 0x2A, 0x32, 0x22, 0x22, 0x00 },  // 'N'
+        { 0x1C, 0x22, 0x22, 0x22, 0x22, 0x22, 0x1C, 0x00 },  // 'O'
+        { 0x1E, 0x22, 0x22, 0x1E, 0x02, 0x02, 0x02, 0x00 },  // 'P'
+        { 0x1C, 0x22, 0x22, 0x22, 0x2A, 0x12, 0x2C, 0x00 },  // 'Q'
+        { 0x1E, 0x22, 0x22, 0x1E, 0x0A, 0x12, 0x22, 0x00 },  // 'R'
+        { 0x3C, 0x02, 0x02, 0x1C, 0x20, 0x20, 0x1E, 0x00 },  // 'S'
+        { 0x3E, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00 },  // 'T'
+        { 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x1C, 0x00 },  // 'U'
+        { 0x22, 0x22, 0x22, 0x22, 0x22, 0x14, 0x08, 0x00 },  // 'V'
+        { 0x22, 0x22, 0x22, 0x2A, 0x2A, 0x2A, 0x14, 0x00 },  // 'W'
+        { 0x22, 0x22, 0x14, 0x08, 0x14, 0x22, 0x22, 0x00 },  // 'X'
+        { 0x22, 0x22, 0x22, 0x14, 0x08, 0x08, 0x08, 0x00 },  // 'Y'
+        { 0x3E, 0x20, 0x10, 0x08, 0x04, 0x02, 0x3E, 0x00 },  // 'Z'
+        { 0x38, 0x08, 0x08, 0x08, 0x08, 0x08, 0x38, 0x00 },  // '['
+        { 0x00, 0x02, 0x04, 0x08, 0x10, 0x20, 0x00, 0x00 },  // '\\'
+        { 0x0E, 0x08, 0x08, 0x08, 0x08, 0x08, 0x0E, 0x00 },  // ']'
+        { 0x08, 0x14, 0x22, 0x00, 0x00, 0x00, 0x00, 0x00 },  // '^'
+        { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3E, 0x00 },  // '_'
+        { 0x08, 0x1C, 0x2A, 0x08, 0x08, 0x08, 0x08, 0x00 },  // up arrow
+        { 0x08, 0x08, 0x08, 0x08, 0x2A, 0x1C, 0x08, 0x00 },  // down arrow
+        { 0x00, 0x08, 0x10, 0x3E, 0x10, 0x08, 0x00, 0x00 },  // right arrow
+        { 0x00, 0x08, 0x04, 0x3E, 0x04, 0x08, 0x00, 0x00 },  // left arrow
+        { 0x3E, 0x3E, 0x3E, 0x3E, 0x3E, 0x3E, 0x3E, 0x00 },  // block
+        { 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00 },  // '|'
+        { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7E },  // bar 1/8
+        { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7E, 0x7E },  // bar 2/8
+        { 0x00, 0x00, 0x00, 0x00, 0x00, 0x7E, 0x7E, 0x7E },  // bar 3/8
+        { 0x00, 0x00, 0x00, 0x00, 0x7E, 0x7E, 0x7E, 0x7E },  // bar 4/8
+        { 0x00, 0x00, 0x00, 0x7E, 0x7E, 0x7E, 0x7E, 0x7E },  // bar 5/8
+        { 0x00, 0x00, 0x7E, 0x7E, 0x7E, 0x7E, 0x7E, 0x7E },  // bar 6/8
+        { 0x00, 0x7E, 0x7E, 0x7E, 0x7E, 0x7E, 0x7E, 0x7E },  // bar 7/8
+        { 0x7E, 0x7E, 0x7E, 0x7E, 0x7E, 0x7E, 0x7E, 0x7E },  // bar 8/8
+};
+
+// Glyph index of a character, unsupported characters are shown as '?'
+constexpr int bgFontGlyph(char character) {
+    if (character >= ' ' && character <= '_') {
+        return character - ' ';
+    }
+    
+    if (character >= 'a' && character <= 'z') {
+        return character - 'a' + 'A' - ' ';
+    }
+    
+    if (character >= '\x18' && character <= '\x1B') {
+        return 64 + character - '\x18';
+    }
+    
+    if (character == '\x7F') {
+        return 68;
+    }
+    
+    if (character == '|') {
+        return 69;
+    }
+    
+    if (character >= '\x01' && character <= '\x08') {
+        return 70 + character - '\x01';
+    }
+    
+    return '?' - ' ';
+}
+
+#endif
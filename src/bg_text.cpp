@@ -0,0 +1,99 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Background tilemap text layer implementation
+ */
+#include "bg_text.h"
+
+#include "bn_tile.h"
+#include "bn_memory.h"
+#include "bn_size.h"
+#include "bn_color.h"
+#include "bn_bg_palette_ptr.h"
+#include "bn_bg_palette_item.h"
+#include "bn_regular_bg_item.h"
+#include "bn_regular_bg_tiles_item.h"
+
+#include "bg_font.h"
+
+namespace {
+    // Palette indexes used by glyph pixels
+    constexpr unsigned TEXT_COLOR_INDEX = 1;
+    constexpr unsigned ACCENT_COLOR_INDEX = 2;
+    
+    constexpr bn::color PALETTE_COLORS[16] = {
+        bn::color(0, 0, 0), bn::color(31, 31, 31), bn::color(31, 31, 31)
+    };
+    
+    // The font is stored twice: glyphs in the text color, then in the accent color
+    struct FontTiles {
+        bn::tile tiles[BG_FONT_GLYPHS * 2];
+    };
+    
+    // Expand the 1bpp font rows into 4bpp tiles at compile time
+    constexpr FontTiles makeFontTiles() {
+        FontTiles result = {};
+        
+        for (int glyph = 0; glyph < BG_FONT_GLYPHS; ++glyph) {
+            for (int row = 0; row < 8; ++row) {
+                unsigned bits = BG_FONT_ROWS[glyph][row];
+                unsigned textPixels = 0;
+                unsigned accentPixels = 0;
+                
+                for (int pixel = 0; pixel < 8; ++pixel) {
+                    if (bits & (1u << pixel)) {
+                        textPixels |= TEXT_COLOR_INDEX << (pixel * 4);
+                        accentPixels |= ACCENT_COLOR_INDEX << (pixel * 4);
+                    }
+                }
+                
+                result.tiles[glyph].data[row] = textPixels;
+                result.tiles[BG_FONT_GLYPHS + glyph].data[row] = accentPixels;
+            }
+        }
+        
+        return result;
+    }
+    
+    constexpr FontTiles FONT_TILES = makeFontTiles();
+    
+    constexpr bn::regular_bg_tiles_item TILES_ITEM(FONT_TILES.tiles, bn::bpp_mode::BPP_4);
+    constexpr bn::bg_palette_item PALETTE_ITEM(PALETTE_COLORS, bn::bpp_mode::BPP_4);
+    
+    // Position the 256x256 map so that cell (0, 0) is the top-left screen corner
+    constexpr int BG_X = (32 * 8 - BG_TEXT_COLUMNS * 8) / 2;
+    constexpr int BG_Y = (32 * 8 - BG_TEXT_ROWS * 8) / 2;
+}
+
+BgText::BgText() :
+    _cells(),
+    _mapItem(_cells[0], bn::size(MAP_COLUMNS, MAP_ROWS)),
+    _bg(bn::regular_bg_item(TILES_ITEM, PALETTE_ITEM, _mapItem).create_bg(BG_X, BG_Y)),
+    _map(_bg.map()) {
+    for (int index = 0; index < 16; ++index) {
+        _paletteColors[index] = PALETTE_COLORS[index];
+    }
+}
+
+void BgText::setAccentColor(bn::color color) {
+    if (_paletteColors[ACCENT_COLOR_INDEX] == color) {
+        return;
+    }
+    
+    _paletteColors[ACCENT_COLOR_INDEX] = color;
+    
+    bn::bg_palette_ptr palette = _bg.palette();
+    palette.set_colors(_paletteColors);
+}
+
+void BgText::load(const BgTextScreen& screen) {
+    // Rows past the visible grid are never written, so they stay blank
+    bn::memory::copy(screen.cells[0], BG_TEXT_MAP_COLUMNS * BG_TEXT_ROWS, _cells[0]);
+    _dirty = true;
+}
+
+void BgText::commit() {
+    if (_dirty && !_held) {
+        _map.reload_cells_ref();
+        _dirty = false;
+    }
+}
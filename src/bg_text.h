@@ -0,0 +1,143 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Background tilemap text layer.
+ *
+ * Text is written as glyph indices straight into a regular background map,
+ * so static screen text costs no sprites or OAM entries. Changes are
+ * uploaded once per frame by commit().
+ */
+#ifndef POMI_BG_TEXT_H
+#define POMI_BG_TEXT_H
+
+#include "bn_color.h"
+#include "bn_string_view.h"
+#include "bn_regular_bg_ptr.h"
+#include "bn_regular_bg_map_ptr.h"
+#include "bn_regular_bg_map_item.h"
+#include "bn_regular_bg_map_cell.h"
+
+#include "code_placement.h"
+#include "bg_font.h"
+
+// Visible text grid, the top-left corner of a 32x32 cell map
+constexpr int BG_TEXT_COLUMNS = 30;
+constexpr int BG_TEXT_ROWS = 20;
+constexpr int BG_TEXT_MAP_COLUMNS = 32;
+
+// Text color: accent text uses the reserved state accent palette slot
+enum class BgTextColor {
+    NORMAL,
+    ACCENT
+};
+
+// Placement of a line relative to its column: starting at it, centered on it
+// or ending just before it
+enum class BgTextAlign {
+    LEFT,
+    CENTER,
+    RIGHT
+};
+
+// A line of static screen text
+struct BgTextLine {
+    int row;
+    int column;
+    bn::string_view text;
+    BgTextColor color = BgTextColor::NORMAL;
+    BgTextAlign align = BgTextAlign::CENTER;
+};
+
+// Visible map rows of a screen's static text, composed at compile time
+struct BgTextScreen {
+    bn::regular_bg_map_cell cells[BG_TEXT_MAP_COLUMNS * BG_TEXT_ROWS];
+};
+
+// Lay out lines into map cells with the same glyphs as BgText::write()
+template<int Lines>
+constexpr BgTextScreen composeBgTextScreen(const BgTextLine (&lines)[Lines]) {
+    BgTextScreen screen = {};
+
+    for (const BgTextLine& line : lines) {
+        int size = static_cast<int>(line.text.size());
+        int column = line.align == BgTextAlign::LEFT ? line.column :
+                     line.align == BgTextAlign::CENTER ? line.column - size / 2 : line.column - size;
+        int firstTile = line.color == BgTextColor::ACCENT ? BG_FONT_GLYPHS : 0;
+
+        for (char character : line.text) {
+            if (line.row >= 0 && line.row < BG_TEXT_ROWS && column >= 0 && column < BG_TEXT_COLUMNS) {
+                screen.cells[line.row * BG_TEXT_MAP_COLUMNS + column] =
+                        bn::regular_bg_map_cell(firstTile + bgFontGlyph(character));
+            }
+
+            ++column;
+        }
+    }
+
+    return screen;
+}
+
+class BgText {
+public:
+    BgText();
+
+    BgText(const BgText& other) = delete;
+    BgText& operator=(const BgText& other) = delete;
+
+    // Write text starting at the given cell
+    POMI_TEXT_CODE void write(int column, int row, const bn::string_view& text,
+                              BgTextColor color = BgTextColor::NORMAL);
+
+    // Write text horizontally centered on the screen, or on the given column
+    POMI_TEXT_CODE void writeCentered(int row, const bn::string_view& text, BgTextColor color = BgTextColor::NORMAL);
+    POMI_TEXT_CODE void writeCentered(int centerColumn, int row, const bn::string_view& text,
+                                      BgTextColor color = BgTextColor::NORMAL);
+
+    // Repeat a character over a run of cells
+    POMI_TEXT_CODE void fill(int column, int row, int count, char character,
+                             BgTextColor color = BgTextColor::NORMAL);
+
+    POMI_TEXT_CODE void clearRow(int row);
+    POMI_TEXT_CODE void clear();
+
+    // Replace all visible text with a precomposed screen, a single block copy
+    void load(const BgTextScreen& screen);
+
+    // Rewrite the state accent palette slot, no map or tile changes needed
+    void setAccentColor(bn::color color);
+
+    // Upload pending map changes, call once per frame
+    void commit();
+
+    // While held, changes stay in the RAM map and commit() uploads nothing,
+    // so the text on display is kept until the next screen is complete
+    void setHeld(bool held) {
+        _held = held;
+    }
+
+    [[nodiscard]] const bn::regular_bg_ptr& bg() const {
+        return _bg;
+    }
+
+    // Cell containing a point in screen-centered pixel coordinates
+    static constexpr int columnAt(int x) {
+        return (BG_TEXT_COLUMNS * 8 / 2 + x) / 8;
+    }
+
+    static constexpr int rowAt(int y) {
+        return (BG_TEXT_ROWS * 8 / 2 + y) / 8;
+    }
+
+private:
+    static constexpr int MAP_COLUMNS = BG_TEXT_MAP_COLUMNS;
+    static constexpr int MAP_ROWS = 32;
+
+    alignas(int) bn::regular_bg_map_cell _cells[MAP_COLUMNS * MAP_ROWS];
+    bn::regular_bg_map_item _mapItem;
+    bn::regular_bg_ptr _bg;
+    bn::regular_bg_map_ptr _map;
+    bn::color _paletteColors[16];
+    bool _dirty = false;
+    bool _held = false;
+};
+
+#endif
@@ -0,0 +1,9 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * BG text writers kept in ROM as Thumb code (POMI_IWRAM_TEXT=0)
+ */
+#include "code_placement.h"
+
+#if !POMI_IWRAM_TEXT
+    #include "bg_text_writers_impl.h"
+#endif
@@ -0,0 +1,69 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * BG text glyph and tilemap writers. Included by bg_text_writers.bn_iwram.cpp
+ * or bg_text_writers.cpp depending on POMI_IWRAM_TEXT.
+ */
+#ifndef POMI_BG_TEXT_WRITERS_IMPL_H
+#define POMI_BG_TEXT_WRITERS_IMPL_H
+
+#include "bg_text.h"
+#include "bg_font.h"
+
+void BgText::write(int column, int row, const bn::string_view& text, BgTextColor color) {
+    if (row < 0 || row >= BG_TEXT_ROWS) {
+        return;
+    }
+    
+    bn::regular_bg_map_cell* rowCells = _cells + row * MAP_COLUMNS;
+    int firstTile = color == BgTextColor::ACCENT ? BG_FONT_GLYPHS : 0;
+    
+    for (char character : text) {
+        if (column >= 0 && column < BG_TEXT_COLUMNS) {
+            rowCells[column] = bn::regular_bg_map_cell(firstTile + bgFontGlyph(character));
+        }
+        
+        ++column;
+    }
+    
+    _dirty = true;
+}
+
+void BgText::writeCentered(int row, const bn::string_view& text, BgTextColor color) {
+    writeCentered(BG_TEXT_COLUMNS / 2, row, text, color);
+}
+
+void BgText::writeCentered(int centerColumn, int row, const bn::string_view& text, BgTextColor color) {
+    write(centerColumn - text.size() / 2, row, text, color);
+}
+
+void BgText::fill(int column, int row, int count, char character, BgTextColor color) {
+    if (row < 0 || row >= BG_TEXT_ROWS) {
+        return;
+    }
+    
+    int firstTile = color == BgTextColor::ACCENT ? BG_FONT_GLYPHS : 0;
+    bn::regular_bg_map_cell cell(firstTile + bgFontGlyph(character));
+    bn::regular_bg_map_cell* rowCells = _cells + row * MAP_COLUMNS;
+    
+    for (int end = column + count; column < end; ++column) {
+        if (column >= 0 && column < BG_TEXT_COLUMNS) {
+            rowCells[column] = cell;
+        }
+    }
+    
+    _dirty = true;
+}
+
+void BgText::clearRow(int row) {
+    fill(0, row, BG_TEXT_COLUMNS, ' ');
+}
+
+void BgText::clear() {
+    for (bn::regular_bg_map_cell& cell : _cells) {
+        cell = 0;
+    }
+    
+    _dirty = true;
+}
+
+#endif
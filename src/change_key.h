@@ -0,0 +1,32 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Version stamp of the inputs a UI element is built from.
+ */
+#ifndef POMI_CHANGE_KEY_H
+#define POMI_CHANGE_KEY_H
+
+class ChangeKey {
+public:
+    // Returns true (and stores the key) if it differs from the last call
+    bool changed(int key) {
+        if (_key == key) {
+            return false;
+        }
+
+        _key = key;
+        return true;
+    }
+
+    // Force the next changed() call to report a change
+    void invalidate() {
+        _key = INVALID_KEY;
+    }
+
+private:
+    // Key value that never matches real inputs
+    static constexpr int INVALID_KEY = -2147483647 - 1;
+
+    int _key = INVALID_KEY;
+};
+
+#endif
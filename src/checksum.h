@@ -0,0 +1,33 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Fletcher-16 checksum for the SRAM blocks.
+ */
+#ifndef POMI_CHECKSUM_H
+#define POMI_CHECKSUM_H
+
+#include <cstdint>
+
+inline uint16_t fletcher16(const void* data, int size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    unsigned sum1 = 0;
+    unsigned sum2 = 0;
+
+    for (int index = 0; index < size; ++index) {
+        // Modulo 255 by subtraction, there is no divide instruction
+        sum1 += bytes[index];
+
+        if (sum1 >= 255) {
+            sum1 -= 255;
+        }
+
+        sum2 += sum1;
+
+        if (sum2 >= 255) {
+            sum2 -= 255;
+        }
+    }
+
+    return static_cast<uint16_t>((sum2 << 8) | sum1);
+}
+
+#endif
@@ -0,0 +1,31 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Clock and config value ranges, and division-free minute splitting.
+ */
+#ifndef POMI_CLOCK_TIME_H
+#define POMI_CLOCK_TIME_H
+
+// Largest value shown as MM:SS
+constexpr int MAX_CLOCK_SECONDS = 99 * 60 + 59;
+
+// Config values are kept within the range of the label tables
+constexpr int MAX_CONFIG_MINUTES = 99;
+constexpr int MAX_CONFIG_SESSIONS = 99;
+
+struct ClockTime {
+    int minutes;
+    int seconds;
+};
+
+// Split seconds into minutes and seconds. The ARM7 has no divide instruction, so
+// seconds / 60 is done as a multiply by 2^21 / 60 and a shift. The product is
+// unsigned so it can't overflow, the result is exact for 0..74938.
+constexpr ClockTime splitClock(int seconds) {
+    int minutes = static_cast<int>((static_cast<unsigned>(seconds) * 34953u) >> 21);
+    return ClockTime{ minutes, seconds - minutes * 60 };
+}
+
+static_assert(splitClock(74938).minutes == 74938 / 60 && splitClock(74938).seconds == 74938 % 60,
+              "splitClock() range");
+
+#endif
@@ -0,0 +1,43 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Placement of the per-frame hot path.
+ *
+ * With a group enabled, its functions are defined in a .bn_iwram.cpp file,
+ * compiled as ARM code and copied to IWRAM, where they run without ROM wait
+ * states. Disabled, the same code is built as Thumb code in ROM. Large
+ * constant tables (font, descriptors) always stay in ROM.
+ */
+#ifndef POMI_CODE_PLACEMENT_H
+#define POMI_CODE_PLACEMENT_H
+
+#include "platform.h"
+
+#if !POMI_HOST
+    #include "bn_common.h"
+#endif
+
+// Timer update and input dispatch (always in regular code on the host)
+#ifndef POMI_IWRAM_CORE
+    #define POMI_IWRAM_CORE (!POMI_HOST)
+#endif
+
+// BG text glyph and tilemap writers
+#ifndef POMI_IWRAM_TEXT
+    #define POMI_IWRAM_TEXT 1
+#endif
+
+static_assert(!POMI_HOST || !POMI_IWRAM_CORE, "There is no IWRAM on the host");
+
+#if POMI_IWRAM_CORE
+    #define POMI_CORE_CODE BN_CODE_IWRAM
+#else
+    #define POMI_CORE_CODE
+#endif
+
+#if POMI_IWRAM_TEXT
+    #define POMI_TEXT_CODE BN_CODE_IWRAM
+#else
+    #define POMI_TEXT_CODE
+#endif
+
+#endif
@@ -0,0 +1,103 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Countdown display implementation
+ */
+#include "countdown_display.h"
+
+#include "bn_sprite_font.h"
+#include "bn_sprite_item.h"
+
+#include "time_format.h"
+
+namespace {
+    // Sprite font graphics start at the space character
+    constexpr int graphicsIndex(char character) {
+        return character - ' ';
+    }
+
+    // Sprite index of each digit (index 2 is the colon)
+    constexpr int DIGIT_SPRITES[] = { 0, 1, 3, 4 };
+}
+
+CountdownDisplay::CountdownDisplay(const bn::sprite_text_generator& text_generator, SpritePool& pool,
+                                   const bn::sprite_palette_ptr& palette, int x, int y) :
+    _pool(pool) {
+    const bn::sprite_item& item = text_generator.font().item();
+    
+    // Cache the ten digit glyphs once
+    for (char digit = '0'; digit <= '9'; ++digit) {
+        _digitTiles.push_back(item.tiles_item().create_tiles(graphicsIndex(digit)));
+    }
+    
+    // Lay glyphs out the same way the generator would center "00:00"
+    int digitWidth = text_generator.width("0");
+    int colonWidth = text_generator.width(":");
+    int left = x - (DIGITS * digitWidth + colonWidth) / 2;
+    int halfSprite = item.shape_size().width() / 2;
+    
+    for (int i = 0; i < DIGITS + 1; ++i) {
+        int glyphX = left + i * digitWidth;
+        
+        if (i > 2) {
+            glyphX += colonWidth - digitWidth;
+        }
+        
+        if (i == 2) {
+            _sprites[i] = _pool.acquire(glyphX + halfSprite, y, item.shape_size(),
+                                        item.tiles_item().create_tiles(graphicsIndex(':')), palette,
+                                        SpritePriority::ESSENTIAL);
+        } else {
+            _sprites[i] = _pool.acquire(glyphX + halfSprite, y, item.shape_size(), _digitTiles[0], palette,
+                                        SpritePriority::ESSENTIAL);
+        }
+    }
+    
+    for (int& digit : _digits) {
+        digit = 0;
+    }
+}
+
+CountdownDisplay::~CountdownDisplay() {
+    for (SpriteHandle sprite : _sprites) {
+        _pool.release(sprite);
+    }
+}
+
+void CountdownDisplay::setSeconds(int seconds) {
+    if (seconds == _seconds) {
+        return;
+    }
+    
+    _seconds = seconds;
+    
+    if (seconds < 0) {
+        seconds = 0;
+    } else if (seconds > MAX_CLOCK_SECONDS) {
+        seconds = MAX_CLOCK_SECONDS;
+    }
+    
+    ClockTime clock = splitClock(seconds);
+    bn::string_view minutesText = TWO_DIGITS[clock.minutes];
+    bn::string_view secondsText = TWO_DIGITS[clock.seconds];
+    int digits[DIGITS] = { minutesText[0] - '0', minutesText[1] - '0', secondsText[0] - '0', secondsText[1] - '0' };
+    
+    // Only touch the sprites whose digit changed
+    for (int i = 0; i < DIGITS; ++i) {
+        if (digits[i] != _digits[i]) {
+            _digits[i] = digits[i];
+            _pool.setTiles(_sprites[DIGIT_SPRITES[i]], _digitTiles[digits[i]]);
+        }
+    }
+}
+
+void CountdownDisplay::setVisible(bool visible) {
+    if (visible == _visible) {
+        return;
+    }
+    
+    _visible = visible;
+    
+    for (SpriteHandle sprite : _sprites) {
+        _pool.setVisible(sprite, visible);
+    }
+}
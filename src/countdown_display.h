@@ -0,0 +1,42 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * MM:SS countdown built from digit glyphs cached in VRAM at startup.
+ * A tick only swaps the tiles of the digit sprites that changed.
+ */
+#ifndef POMI_COUNTDOWN_DISPLAY_H
+#define POMI_COUNTDOWN_DISPLAY_H
+
+#include "bn_vector.h"
+#include "bn_sprite_tiles_ptr.h"
+#include "bn_sprite_palette_ptr.h"
+#include "bn_sprite_text_generator.h"
+
+#include "sprite_pool.h"
+
+class CountdownDisplay {
+public:
+    // Glyphs and metrics are taken from the generator's font, centered on (x, y)
+    CountdownDisplay(const bn::sprite_text_generator& text_generator, SpritePool& pool,
+                     const bn::sprite_palette_ptr& palette, int x, int y);
+    ~CountdownDisplay();
+
+    CountdownDisplay(const CountdownDisplay&) = delete;
+    CountdownDisplay& operator=(const CountdownDisplay&) = delete;
+
+    // Show the given time as MM:SS (clamped to 99:59)
+    void setSeconds(int seconds);
+
+    void setVisible(bool visible);
+
+private:
+    static constexpr int DIGITS = 4;
+
+    bn::vector<bn::sprite_tiles_ptr, 10> _digitTiles;
+    SpritePool& _pool;
+    SpriteHandle _sprites[DIGITS + 1];  // M, M, :, S, S
+    int _digits[DIGITS];
+    int _seconds = -1;
+    bool _visible = true;
+};
+
+#endif
@@ -0,0 +1,44 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Deadline scheduler implementation
+ */
+#include "deadline_scheduler.h"
+
+void DeadlineScheduler::schedule(DeadlineId id, uint32_t deadline) {
+    cancel(id);
+
+    // Shift later deadlines down until the insertion point, ties fire in scheduling order
+    int index = _count;
+
+    while (index > 0 && _entries[index - 1].deadline <= deadline) {
+        _entries[index] = _entries[index - 1];
+        --index;
+    }
+
+    _entries[index] = { deadline, id };
+    ++_count;
+}
+
+void DeadlineScheduler::cancel(DeadlineId id) {
+    int index = find(id);
+
+    if (index < 0) {
+        return;
+    }
+
+    --_count;
+
+    for (; index < _count; ++index) {
+        _entries[index] = _entries[index + 1];
+    }
+}
+
+int DeadlineScheduler::find(DeadlineId id) const {
+    for (int index = 0; index < _count; ++index) {
+        if (_entries[index].id == id) {
+            return index;
+        }
+    }
+
+    return -1;
+}
@@ -0,0 +1,66 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Deadline scheduler for timed events.
+ *
+ * Each event has one absolute deadline in session clock seconds. Entries are
+ * kept sorted, latest first, so the earliest deadline is always the last one
+ * and a frame with nothing due costs a single comparison no matter how many
+ * events are scheduled.
+ */
+#ifndef POMI_DEADLINE_SCHEDULER_H
+#define POMI_DEADLINE_SCHEDULER_H
+
+#include <cstdint>
+
+// Scheduled events, at most one deadline each
+enum class DeadlineId : uint8_t {
+    IDLE_SLEEP,         // Paused without input for too long
+    STRETCH,            // Reminders
+    HYDRATE,
+    ALERT_CLEAR,        // Hide the reminder alert
+};
+
+constexpr int DEADLINE_IDS = 4;
+
+// Deadline of an event that is not scheduled
+constexpr uint32_t NO_DEADLINE = UINT32_MAX;
+
+class DeadlineScheduler {
+public:
+    // Set or move the deadline of an event
+    void schedule(DeadlineId id, uint32_t deadline);
+
+    void cancel(DeadlineId id);
+
+    [[nodiscard]] bool scheduled(DeadlineId id) const {
+        return find(id) >= 0;
+    }
+
+    // Earliest deadline, NO_DEADLINE if nothing is scheduled
+    [[nodiscard]] uint32_t next() const {
+        return _count ? _entries[_count - 1].deadline : NO_DEADLINE;
+    }
+
+    // Take the earliest event if its deadline has been reached
+    [[nodiscard]] bool popDue(uint32_t now, DeadlineId& id) {
+        if (!_count || now < _entries[_count - 1].deadline) {
+            return false;
+        }
+
+        id = _entries[--_count].id;
+        return true;
+    }
+
+private:
+    struct Entry {
+        uint32_t deadline;
+        DeadlineId id;
+    };
+
+    Entry _entries[DEADLINE_IDS];   // Sorted by deadline, latest first
+    int _count = 0;
+
+    [[nodiscard]] int find(DeadlineId id) const;
+};
+
+#endif
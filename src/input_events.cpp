@@ -0,0 +1,63 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Input event queue implementation
+ */
+#include "input_events.h"
+
+void InputEvents::fill(KeyInput keys) {
+    // The queue is drained every frame, so it restarts from the front
+    if (empty()) {
+        _head = 0;
+        _tail = 0;
+    }
+
+    for (uint16_t key = KeyInput::A; key <= KeyInput::DOWN; key = static_cast<uint16_t>(key << 1)) {
+        if (keys.has(key)) {
+            push(key, 1, false);
+        }
+    }
+
+    // A new direction press takes over the repeat
+    uint16_t direction = keys.pressed & KeyInput::DIRECTIONS;
+
+    if (direction) {
+        _repeatKey = direction & -direction;
+        _heldFrames = 0;
+        _repeats = 0;
+        return;
+    }
+
+    if (!(keys.held & _repeatKey)) {
+        _repeatKey = 0;
+        return;
+    }
+
+    ++_heldFrames;
+
+    if (_heldFrames < POMI_REPEAT_DELAY_FRAMES || (_heldFrames - POMI_REPEAT_DELAY_FRAMES) % POMI_REPEAT_RATE_FRAMES) {
+        return;
+    }
+
+    ++_repeats;
+    push(_repeatKey, _repeats > POMI_REPEAT_ACCEL_REPEATS ? POMI_REPEAT_ACCEL_STEP : 1, true);
+}
+
+bool InputEvents::pop(InputEvent& event) {
+    if (empty()) {
+        return false;
+    }
+
+    event = _events[_head++];
+    return true;
+}
+
+void InputEvents::push(uint16_t key, int step, bool repeat) {
+    if (_tail == CAPACITY) {
+        return;
+    }
+
+    InputEvent& event = _events[_tail++];
+    event.key = key;
+    event.step = static_cast<uint8_t>(step);
+    event.repeat = repeat;
+}
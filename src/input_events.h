@@ -0,0 +1,74 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Input event queue with held key auto-repeat.
+ *
+ * Each frame's KeyInput is turned into one event per key press, plus a
+ * repeat of the last pressed direction while it is held: the first after
+ * POMI_REPEAT_DELAY_FRAMES, then one every POMI_REPEAT_RATE_FRAMES. After
+ * POMI_REPEAT_ACCEL_REPEATS repeats the step accelerates to
+ * POMI_REPEAT_ACCEL_STEP, so a held direction in the config menu moves a
+ * value by 1 minute at first and by 5 minutes afterwards.
+ *
+ * The queue only depends on KeyInput, so recorded traces and the host
+ * simulation produce the same events as the keypad.
+ */
+#ifndef POMI_INPUT_EVENTS_H
+#define POMI_INPUT_EVENTS_H
+
+#include <cstdint>
+
+#include "platform.h"
+
+#ifndef POMI_REPEAT_DELAY_FRAMES
+    #define POMI_REPEAT_DELAY_FRAMES 20
+#endif
+
+#ifndef POMI_REPEAT_RATE_FRAMES
+    #define POMI_REPEAT_RATE_FRAMES 4
+#endif
+
+#ifndef POMI_REPEAT_ACCEL_REPEATS
+    #define POMI_REPEAT_ACCEL_REPEATS 8
+#endif
+
+#ifndef POMI_REPEAT_ACCEL_STEP
+    #define POMI_REPEAT_ACCEL_STEP 5
+#endif
+
+static_assert(POMI_REPEAT_DELAY_FRAMES > 0 && POMI_REPEAT_RATE_FRAMES > 0, "Repeat periods must be positive");
+static_assert(POMI_REPEAT_ACCEL_STEP >= 1 && POMI_REPEAT_ACCEL_STEP < 256, "Invalid accelerated step");
+
+struct InputEvent {
+    uint16_t key = 0;       // A single KeyInput bit
+    uint8_t step = 1;       // Value step, POMI_REPEAT_ACCEL_STEP once a repeat has accelerated
+    bool repeat = false;    // Generated by a held direction
+};
+
+class InputEvents {
+public:
+    // A press of every key, plus one repeat
+    static constexpr int CAPACITY = 9;
+
+    // Queue the events of this frame's keys, call once per frame
+    void fill(KeyInput keys);
+
+    // Take the oldest event, returns false if there is none
+    bool pop(InputEvent& event);
+
+    [[nodiscard]] bool empty() const {
+        return _head == _tail;
+    }
+
+private:
+    InputEvent _events[CAPACITY];
+    int _head = 0;
+    int _tail = 0;
+
+    uint16_t _repeatKey = 0;    // Direction repeated while held
+    int _heldFrames = 0;
+    int _repeats = 0;
+
+    void push(uint16_t key, int step, bool repeat);
+};
+
+#endif
@@ -0,0 +1,295 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Input trace implementation
+ */
+#include "input_trace.h"
+
+#if POMI_INPUT_RECORD || POMI_INPUT_REPLAY
+
+#include <cstddef>
+
+#include "bn_log.h"
+#include "bn_sram.h"
+#include "bn_string.h"
+#include "bn_keypad.h"
+
+#include "pomodoro_core.h"
+#include "input_events.h"
+#include "checksum.h"
+#include "varint.h"
+
+static_assert(!POMI_HW_SECONDS, "Hardware timer seconds don't follow the replayed ticks");
+
+namespace {
+    constexpr uint32_t TRACE_MAGIC = 0x45435254;  // "TRCE"
+    constexpr uint16_t TRACE_VERSION = 2;
+
+    constexpr int RUN_MAX_BYTES = 3 * VARINT_MAX_BYTES;
+
+    // Pressed keys in the low byte of a run's keys, held directions in the high one
+    constexpr int HELD_SHIFT = 8;
+
+    uint16_t packKeys(KeyInput keys) {
+        return static_cast<uint16_t>(keys.pressed | (keys.held << HELD_SHIFT));
+    }
+
+    // Encoded runs, kept out of IWRAM
+    BN_DATA_EWRAM uint8_t traceData[INPUT_TRACE_BYTES];
+
+    uint16_t traceChecksum(const InputTraceHeader& header) {
+        uint16_t fields = fletcher16(&header.version,
+                                     int(offsetof(InputTraceHeader, checksum) - offsetof(InputTraceHeader, version)));
+        uint16_t data = fletcher16(traceData, header.size);
+        return static_cast<uint16_t>(fields ^ data);
+    }
+}
+
+bool InputTrace::append(uint16_t keys, unsigned ticks) {
+    if (_runFrames && keys == _runKeys && ticks == _runTicks) {
+        ++_runFrames;
+        ++_frames;
+        return true;
+    }
+
+    if (_runFrames && !closeRun()) {
+        return false;
+    }
+
+    _runKeys = keys;
+    _runTicks = ticks;
+    _runFrames = 1;
+    ++_frames;
+    return true;
+}
+
+bool InputTrace::closeRun() {
+    if (INPUT_TRACE_BYTES - _size < RUN_MAX_BYTES) {
+        return false;
+    }
+
+    _size += putVarint(traceData + _size, _runFrames);
+    _size += putVarint(traceData + _size, _runKeys);
+    _size += putVarint(traceData + _size, _runTicks);
+    _runFrames = 0;
+    return true;
+}
+
+#if POMI_INPUT_RECORD
+
+void InputTrace::begin() {
+    _lastTicks = _timer.elapsed_ticks();
+}
+
+KeyInput InputTrace::frame(KeyInput live) {
+    unsigned now = _timer.elapsed_ticks();
+    unsigned ticks = now - _lastTicks;
+    _lastTicks = now;
+
+    // The dump combo is not passed on, so that the replay sees the same keys
+    bool dumpRequested = bn::keypad::start_pressed() && bn::keypad::l_held() && bn::keypad::r_held();
+
+    if (dumpRequested) {
+        live = KeyInput();
+    }
+
+    if (!_full && !append(packKeys(live), ticks)) {
+        _full = true;
+        dumpRequested = true;
+    }
+
+    if (dumpRequested) {
+        dump();
+    }
+
+    return live;
+}
+
+void InputTrace::dump() {
+    // The open run is encoded for the dump and keeps growing afterwards
+    int size = _size;
+    uint32_t runFrames = _runFrames;
+    uint32_t frames = _frames;
+
+    if (runFrames && !closeRun()) {
+        frames -= runFrames;
+    }
+
+    InputTraceHeader header = {};
+    header.magic = TRACE_MAGIC;
+    header.version = TRACE_VERSION;
+    header.size = static_cast<uint16_t>(_size);
+    header.frames = frames;
+    header.checksum = traceChecksum(header);
+
+    bn::sram::write_offset(traceData, INPUT_TRACE_OFFSET + int(sizeof(InputTraceHeader)));
+    bn::sram::write_offset(header, INPUT_TRACE_OFFSET);
+
+    BN_LOG("trace frames: ", header.frames, " bytes: ", header.size, _full ? " (full)" : "");
+
+    constexpr int LINE_BYTES = 32;
+    constexpr char DIGITS[] = "0123456789abcdef";
+
+    for (int offset = 0; offset < _size; offset += LINE_BYTES) {
+        bn::string<LINE_BYTES * 2> line;
+
+        for (int index = offset; index < _size && index < offset + LINE_BYTES; ++index) {
+            line.push_back(DIGITS[traceData[index] >> 4]);
+            line.push_back(DIGITS[traceData[index] & 0xF]);
+        }
+
+        BN_LOG("trace ", offset, ": ", line);
+    }
+
+    _size = size;
+    _runFrames = runFrames;
+}
+
+#else
+
+namespace {
+    // 280896 CPU cycles per frame, 64 per timer tick
+    constexpr unsigned SCENARIO_FRAME_TICKS = 4389;
+
+    constexpr int scenarioFrames(int seconds) {
+        return int(unsigned(seconds) * TICKS_PER_SECOND / SCENARIO_FRAME_TICKS) + 1;
+    }
+
+    // Each press is a single frame, its key then stays held for holdFrames
+    // frames (directions only), followed by gapFrames frames without input
+    struct ScenarioStep {
+        uint16_t keys;
+        uint16_t presses;
+        int gapFrames;
+        int holdFrames = 0;
+    };
+
+    constexpr int MENU_GAP = 4;
+
+    // Long enough for the auto-repeat to bring any value down to its minimum
+    constexpr int HOLD_TO_MINIMUM = POMI_REPEAT_DELAY_FRAMES + POMI_REPEAT_RATE_FRAMES *
+        (POMI_REPEAT_ACCEL_REPEATS + (MAX_CONFIG_MINUTES + POMI_REPEAT_ACCEL_STEP - 1) / POMI_REPEAT_ACCEL_STEP);
+
+    // One minute intervals, plus a second for the transition
+    constexpr int INTERVAL_FRAMES = scenarioFrames(61);
+    constexpr int PAUSE_AFTER_FRAMES = scenarioFrames(20);
+
+    // Values are clamped at their minimum, so the steps don't depend on the defaults
+    constexpr ScenarioStep SCENARIO[] = {
+        { 0, 1, 30 },
+
+        // Configure 1 minute intervals and sets of 2, holding LEFT down
+        { KeyInput::SELECT, 1, 10 },
+        { KeyInput::LEFT, 1, MENU_GAP, HOLD_TO_MINIMUM },
+        { KeyInput::DOWN, 1, MENU_GAP },
+        { KeyInput::LEFT, 1, MENU_GAP, HOLD_TO_MINIMUM },
+        { KeyInput::DOWN, 1, MENU_GAP },
+        { KeyInput::LEFT, 1, MENU_GAP, HOLD_TO_MINIMUM },
+        { KeyInput::DOWN, 1, MENU_GAP },
+        { KeyInput::LEFT, 1, MENU_GAP, HOLD_TO_MINIMUM },
+        { KeyInput::RIGHT, 1, MENU_GAP },
+        { KeyInput::B, 1, 30 },
+
+        // First set: work, short break, work paused for 5 seconds, long break
+        { KeyInput::A, 2, INTERVAL_FRAMES },
+        { KeyInput::A, 1, PAUSE_AFTER_FRAMES },
+        { KeyInput::A, 1, scenarioFrames(5) },
+        { KeyInput::A, 1, INTERVAL_FRAMES - PAUSE_AFTER_FRAMES },
+        { KeyInput::A, 1, INTERVAL_FRAMES },
+
+        // Second set
+        { KeyInput::A, 4, INTERVAL_FRAMES },
+
+        // Reset a running interval
+        { KeyInput::A, 1, scenarioFrames(10) },
+        { KeyInput::B, 1, 60 },
+    };
+}
+
+void InputTrace::begin() {
+    if (load()) {
+        BN_LOG("replay sram trace frames: ", _frames, " bytes: ", _size);
+    } else {
+        encodeScenario();
+        BN_LOG("replay scenario frames: ", _frames, " bytes: ", _size);
+    }
+}
+
+KeyInput InputTrace::frame(KeyInput live) {
+    while (!_runFrames && !_ended) {
+        uint32_t frames;
+        uint32_t keys;
+        uint32_t ticks;
+
+        if (getVarint(traceData, _size, _position, frames) && getVarint(traceData, _size, _position, keys) &&
+                getVarint(traceData, _size, _position, ticks)) {
+            _runFrames = frames;
+            _runKeys = static_cast<uint16_t>(keys);
+            _runTicks = ticks;
+        } else {
+            _ended = true;
+            BN_LOG("replay ended");
+        }
+    }
+
+    // Time keeps going at the last frame's rate after the end
+    TickClock::advanceReplay(_runTicks);
+
+    if (_ended) {
+        return live;
+    }
+
+    --_runFrames;
+    KeyInput keys;
+    keys.pressed = _runKeys & ((1 << HELD_SHIFT) - 1);
+    keys.held = _runKeys >> HELD_SHIFT;
+    return keys;
+}
+
+bool InputTrace::load() {
+    InputTraceHeader header;
+    bn::sram::read_offset(header, INPUT_TRACE_OFFSET);
+
+    if (header.magic != TRACE_MAGIC || header.version != TRACE_VERSION || header.size > INPUT_TRACE_BYTES) {
+        return false;
+    }
+
+    bn::sram::read_offset(traceData, INPUT_TRACE_OFFSET + int(sizeof(InputTraceHeader)));
+
+    if (header.checksum != traceChecksum(header)) {
+        return false;
+    }
+
+    _size = header.size;
+    _frames = header.frames;
+    return true;
+}
+
+void InputTrace::encodeScenario() {
+    _size = 0;
+    _frames = 0;
+    _runFrames = 0;
+
+    for (const ScenarioStep& step : SCENARIO) {
+        for (int press = 0; press < step.presses; ++press) {
+            KeyInput keys;
+            keys.pressed = step.keys;
+            keys.held = step.keys & KeyInput::DIRECTIONS;
+            append(packKeys(keys), SCENARIO_FRAME_TICKS);
+            keys.pressed = 0;
+
+            for (int hold = 0; hold < step.holdFrames; ++hold) {
+                append(packKeys(keys), SCENARIO_FRAME_TICKS);
+            }
+
+            for (int gap = 0; gap < step.gapFrames; ++gap) {
+                append(0, SCENARIO_FRAME_TICKS);
+            }
+        }
+    }
+
+    closeRun();
+}
+
+#endif
+
+#endif
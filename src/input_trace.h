@@ -0,0 +1,102 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Input trace recording and replay, for reproducible performance runs.
+ *
+ * A trace is the per-frame stream of keys fed to the input event queue and
+ * ticks read from ctx.timer, run-length encoded: each run of identical frames
+ * is three varints (frame count, pressed keys and held directions, ticks
+ * since the previous frame). Holding a direction repeats the same frame, so
+ * auto-repeat replays from a couple of runs. On the vsync-locked main loop
+ * idle frames all advance by the same ticks, so minutes without input take
+ * a few bytes.
+ *
+ * POMI_INPUT_RECORD builds record the live input and dump the trace to SRAM
+ * and bn::log when it fills up or when L+R+START is pressed. POMI_INPUT_REPLAY
+ * builds feed a trace back instead of bn::keypad and bn::timer: the one dumped
+ * to SRAM if there is one, otherwise a built-in "configure, run two sets,
+ * pause, reset" scenario. Both start from the default settings instead of the
+ * saved ones and never sleep, so a replay follows the recorded run frame for
+ * frame; with POMI_PERF_HUD the perf log lines then trace the same workload
+ * in every build. Trace builds overwrite the save block and keep a shorter
+ * session history.
+ *
+ * Otherwise InputTrace is an empty inline pass-through.
+ */
+#ifndef POMI_INPUT_TRACE_H
+#define POMI_INPUT_TRACE_H
+
+#include <cstdint>
+
+#include "platform.h"
+#include "sram_layout.h"
+
+constexpr bool INPUT_TRACE = POMI_INPUT_RECORD || POMI_INPUT_REPLAY;
+
+static_assert(!(POMI_INPUT_RECORD && POMI_INPUT_REPLAY), "A build either records or replays its input");
+static_assert(!INPUT_TRACE || !POMI_HOST, "The host simulation scripts its own input");
+
+#if POMI_INPUT_RECORD || POMI_INPUT_REPLAY
+
+struct InputTraceHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t size;          // Encoded bytes following the header
+    uint32_t frames;
+    uint16_t checksum;      // Fletcher-16 of version, size and frames, xor that of the encoded bytes
+    uint16_t reserved;
+};
+
+constexpr int INPUT_TRACE_BYTES = INPUT_TRACE_MAX_SIZE - int(sizeof(InputTraceHeader));
+
+class InputTrace {
+public:
+    // Replay builds load the SRAM trace, or encode the built-in scenario
+    void begin();
+
+    // Keys for this frame, call once per frame before InputEvents::fill(). Recording
+    // passes the live keys through; replay returns the recorded ones and
+    // advances TickClock, then the live keys once the trace has ended
+    KeyInput frame(KeyInput live);
+
+private:
+    int _size = 0;              // Encoded bytes, the open run excluded
+    uint32_t _frames = 0;
+    uint16_t _runKeys = 0;
+    unsigned _runTicks = 0;
+    uint32_t _runFrames = 0;    // Frames in the open run, or left in the current run when replaying
+#if POMI_INPUT_RECORD
+    bn::timer _timer;
+    unsigned _lastTicks = 0;
+    bool _full = false;
+
+    void dump();
+#else
+    int _position = 0;          // Decoded bytes
+    bool _ended = false;
+
+    bool load();
+    void encodeScenario();
+#endif
+
+    // Add one frame to the open run, returns false if the trace is full
+    bool append(uint16_t keys, unsigned ticks);
+
+    // Encode the open run, returns false if it doesn't fit
+    bool closeRun();
+};
+
+#else
+
+class InputTrace {
+public:
+    void begin() {
+    }
+
+    KeyInput frame(KeyInput live) {
+        return live;
+    }
+};
+
+#endif
+
+#endif
@@ -0,0 +1,259 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Link cable group mode implementation
+ */
+#include "link_sync.h"
+
+#if POMI_LINK
+
+#include "bn_link.h"
+#include "bn_link_state.h"
+
+#include "checksum.h"
+
+static_assert(!POMI_HW_SECONDS, "Followers slew the tick timebase");
+
+namespace {
+    enum PacketType {
+        PACKET_PRESENCE,
+        PACKET_FULL,
+        PACKET_TIME,
+        PACKET_TYPES
+    };
+
+    constexpr int PACKET_WORDS[PACKET_TYPES] = { 1, 5, 3 };
+
+    static_assert(PACKET_WORDS[PACKET_FULL] <= LINK_MAX_PACKET_WORDS, "Packet buffers too small");
+
+    // Header words are 0x8000-0xBFFF, payload words 0x0000-0x7FFF
+    constexpr uint16_t HEADER_BIT = 0x8000;
+    constexpr int TYPE_SHIFT = 11;
+    constexpr uint16_t TYPE_MASK = 0x7;
+    constexpr uint16_t FIELD_MASK = 0x7FF;
+    constexpr uint16_t PAYLOAD_MASK = 0x7FFF;
+
+    // Sub-second phase resolution, 1/2048 second
+    constexpr int PHASE_BITS = 11;
+
+    // Every few drift corrections are sent as FULL packets
+    constexpr int FULL_SYNCS = 8;
+
+    // Seconds without link transfers before the group is considered gone
+    constexpr uint32_t TIMEOUT_SECONDS = 3 * POMI_LINK_SYNC_SECONDS;
+
+    // Largest correction slewed per frame, about 6% of the frame time
+    constexpr int SLEW_TICKS = int(TICKS_PER_SECOND / 1024);
+
+    constexpr uint16_t headerWord(int type, int field) {
+        return static_cast<uint16_t>(HEADER_BIT | (type << TYPE_SHIFT) | field);
+    }
+
+    static_assert(headerWord(PACKET_TYPES - 1, FIELD_MASK) < 0xC000, "Header words out of range");
+
+    // Menus are not broadcast, followers wait in standby meanwhile
+    PomodoroState sharedState(PomodoroState state) {
+        return state == PomodoroState::CONFIG || state == PomodoroState::STATS ? PomodoroState::IDLE : state;
+    }
+
+    int statusField(PomodoroState state, bool active) {
+        return (static_cast<int>(state) << 1) | active;
+    }
+
+    uint16_t configHash(const PomodoroConfig& config) {
+        const uint16_t values[] = {
+            static_cast<uint16_t>(config.workTime), static_cast<uint16_t>(config.shortBreakTime),
+            static_cast<uint16_t>(config.longBreakTime), static_cast<uint16_t>(config.sessionsPerSet)
+        };
+
+        return fletcher16(values, int(sizeof(values))) & PAYLOAD_MASK;
+    }
+}
+
+bool LinkSync::update(PomodoroContext& ctx) {
+    unsigned now = ctx.timer.elapsed_ticks();
+    bool changed = false;
+
+    // Packets from anyone but the leader only keep the link alive
+    while (bn::optional<bn::link_state> state = bn::link::receive()) {
+        _playerId = state->current_player_id();
+        _players = state->player_count();
+        _lastReceived = ctx.clockSeconds;
+
+        for (const bn::link_player& player : state->other_players()) {
+            if (player.id() == 0) {
+                if (receive(static_cast<uint16_t>(player.data()), now) && follow(ctx, now)) {
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    GroupRole role = GroupRole::SOLO;
+    int players = 1;
+
+    if (_players > 1 && ctx.clockSeconds - _lastReceived <= TIMEOUT_SECONDS) {
+        role = _playerId == 0 ? GroupRole::LEADER : GroupRole::FOLLOWER;
+        players = _players;
+    }
+
+    if (role != ctx.groupRole || players != ctx.groupPlayers) {
+        // A new leader sends its whole state first
+        _fullDue = true;
+        _slewTicks = 0;
+        ctx.groupRole = role;
+        ctx.groupPlayers = players;
+        ctx.groupConfigMatch = true;
+        changed = true;
+    }
+
+    bool syncDue = ctx.clockSeconds >= _nextSync || _nextSync - ctx.clockSeconds > POMI_LINK_SYNC_SECONDS;
+
+    if (syncDue) {
+        _nextSync = ctx.clockSeconds + POMI_LINK_SYNC_SECONDS;
+    }
+
+    if (role == GroupRole::LEADER) {
+        lead(ctx, syncDue);
+    } else if (syncDue && _outSent == _outSize) {
+        // Solo units announce themselves too, the link only runs while someone sends
+        pack(ctx, PACKET_PRESENCE);
+    }
+
+    // Small errors are spread over several frames so the countdown never jumps
+    if (role == GroupRole::FOLLOWER && ctx.timerActive && _slewTicks) {
+        int step = _slewTicks < -SLEW_TICKS ? -SLEW_TICKS : _slewTicks > SLEW_TICKS ? SLEW_TICKS : _slewTicks;
+        _slewTicks -= ctx.timebase.slew(step);
+    }
+
+    if (_outSent < _outSize) {
+        bn::link::send(_out[_outSent++]);
+    }
+
+    return changed;
+}
+
+void LinkSync::lead(PomodoroContext& ctx, bool syncDue) {
+    int status = statusField(sharedState(ctx.state), ctx.timerActive);
+
+    // A reset or a new interval moves the countdown up
+    bool jumped = ctx.secondsRemaining > _lastRemaining;
+    _lastRemaining = ctx.secondsRemaining;
+
+    if (jumped || status != _sentStatus || ctx.completedSessions != _sentSessions ||
+            configHash(ctx.config) != _sentHash) {
+        _fullDue = true;
+    }
+
+    // Packets are only built once the previous one is out, so their time is current
+    if (_outSent < _outSize) {
+        return;
+    }
+
+    if (syncDue && ++_syncs % FULL_SYNCS == 0) {
+        _fullDue = true;
+    }
+
+    if (_fullDue) {
+        pack(ctx, PACKET_FULL);
+    } else if (syncDue) {
+        pack(ctx, PACKET_TIME);
+    }
+}
+
+void LinkSync::pack(PomodoroContext& ctx, int type) {
+    PomodoroState state = sharedState(ctx.state);
+    bool active = ctx.timerActive && state == ctx.state;
+    int status = statusField(state, active);
+
+    _out[0] = headerWord(type, type == PACKET_PRESENCE ? 0 : status);
+    _outSize = PACKET_WORDS[type];
+    _outSent = 0;
+
+    if (type == PACKET_PRESENCE) {
+        return;
+    }
+
+    _out[1] = static_cast<uint16_t>(ctx.secondsRemaining & PAYLOAD_MASK);
+    _out[2] = static_cast<uint16_t>(ctx.timebase.remainderFraction() >> (12 - PHASE_BITS));
+
+    if (type == PACKET_FULL) {
+        _sentStatus = status;
+        _sentSessions = ctx.completedSessions;
+        _sentHash = configHash(ctx.config);
+        _fullDue = false;
+
+        _out[3] = static_cast<uint16_t>(ctx.completedSessions & PAYLOAD_MASK);
+        _out[4] = _sentHash;
+    }
+}
+
+bool LinkSync::receive(uint16_t word, unsigned now) {
+    if (word & HEADER_BIT) {
+        // A header always starts a new packet, so a lost word only drops one packet
+        int type = (word >> TYPE_SHIFT) & TYPE_MASK;
+        _inSize = 0;
+        _inExpected = type < PACKET_TYPES ? PACKET_WORDS[type] : 0;
+        _inTicks = now;
+    } else if (_inSize == 0 || _inSize >= _inExpected) {
+        // Payload without its header
+        return false;
+    }
+
+    if (!_inExpected) {
+        return false;
+    }
+
+    _in[_inSize++] = word;
+    return _inSize == _inExpected;
+}
+
+bool LinkSync::follow(PomodoroContext& ctx, unsigned now) {
+    int type = (_in[0] >> TYPE_SHIFT) & TYPE_MASK;
+    int field = _in[0] & FIELD_MASK;
+    int stateIndex = field >> 1;
+
+    // Our own menus are left alone, a later packet catches up
+    if (type == PACKET_PRESENCE || stateIndex > static_cast<int>(PomodoroState::LONG_BREAK) ||
+            ctx.state == PomodoroState::CONFIG || ctx.state == PomodoroState::STATS) {
+        return false;
+    }
+
+    PomodoroState state = static_cast<PomodoroState>(stateIndex);
+    bool active = field & 1;
+    bool changed = state != ctx.state || active != ctx.timerActive;
+    followState(ctx, state);
+    setTimerActive(ctx, active);
+
+    if (type == PACKET_FULL) {
+        // Only the low bits are sent
+        int sessions = (ctx.completedSessions & ~int(PAYLOAD_MASK)) | _in[3];
+        changed = changed || sessions != ctx.completedSessions;
+        ctx.completedSessions = sessions;
+        ctx.groupConfigMatch = _in[4] == configHash(ctx.config);
+    }
+
+    // Both countdowns in remaining ticks, the leader's aged by the local
+    // ticks since its header arrived
+    int64_t phase = int64_t(_in[2] & ((1 << PHASE_BITS) - 1)) * TICKS_PER_SECOND >> PHASE_BITS;
+    int64_t leader = int64_t(_in[1]) * TICKS_PER_SECOND - phase - (active ? int64_t(now - _inTicks) : 0);
+    int64_t local = int64_t(ctx.secondsRemaining) * TICKS_PER_SECOND - ctx.timebase.remainderTicks();
+    int64_t error = local - leader;
+
+    if (!changed && active && error < TICKS_PER_SECOND && error > -int64_t(TICKS_PER_SECOND)) {
+        _slewTicks = int(error);
+        return false;
+    }
+
+    // Applied at once, within our own interval length if the configs differ
+    int64_t duration = int64_t(stateDuration(ctx)) * TICKS_PER_SECOND;
+    leader = leader < 1 ? 1 : leader > duration ? duration : leader;
+
+    int seconds = int((leader + TICKS_PER_SECOND - 1) / TICKS_PER_SECOND);
+    changed = changed || seconds != ctx.secondsRemaining;
+    ctx.secondsRemaining = seconds;
+    ctx.timebase.reset(now, unsigned(int64_t(seconds) * TICKS_PER_SECOND - leader));
+    _slewTicks = 0;
+    return changed;
+}
+
+#endif
@@ -0,0 +1,102 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Link cable group mode.
+ *
+ * Player 0 of the link is the leader and broadcasts its timer; the other
+ * units follow it. Packets are a header word (bit 15 set, packet type and
+ * state in the low bits) followed by 15-bit payload words, sent one word per
+ * frame:
+ *
+ *   FULL      state, running, seconds remaining, sub-second phase,
+ *             completed sessions, config hash
+ *   TIME      state, running, seconds remaining, sub-second phase
+ *   PRESENCE  header only
+ *
+ * The leader sends FULL on transitions, starts, pauses, resets and config
+ * changes, and TIME every POMI_LINK_SYNC_SECONDS, with every few of them
+ * sent as FULL for units that joined late. Followers only send PRESENCE at
+ * the same period so the leader counts them. With four units that is a few
+ * serial transfers every couple of seconds instead of one per frame.
+ *
+ * A follower keeps counting on its own and compares its remaining ticks with
+ * the leader's, aged by the local ticks since the header arrived. Errors
+ * under a second are slewed into its Timebase a little each frame; larger
+ * ones, and state or run changes, are applied at once.
+ *
+ * Only compiled in when POMI_LINK is set. Otherwise LinkSync is an empty
+ * inline class.
+ */
+#ifndef POMI_LINK_SYNC_H
+#define POMI_LINK_SYNC_H
+
+#include <cstdint>
+
+#include "pomodoro_core.h"
+
+#ifndef POMI_LINK
+    #define POMI_LINK 0
+#endif
+
+// Seconds between drift corrections
+#ifndef POMI_LINK_SYNC_SECONDS
+    #define POMI_LINK_SYNC_SECONDS 2
+#endif
+
+static_assert(!POMI_HOST || !POMI_LINK, "There is no link port on the host");
+
+#if POMI_LINK
+
+constexpr int LINK_MAX_PACKET_WORDS = 5;
+
+class LinkSync {
+public:
+    // Exchange packets and lock the timer to the leader's. Call once per
+    // frame after updateTimer(). Returns true if the screen needs a redraw
+    bool update(PomodoroContext& ctx);
+
+private:
+    // Outgoing packet, one word sent per frame
+    uint16_t _out[LINK_MAX_PACKET_WORDS] = {};
+    int _outSize = 0;
+    int _outSent = 0;
+
+    // Incoming leader packet
+    uint16_t _in[LINK_MAX_PACKET_WORDS] = {};
+    int _inSize = 0;
+    int _inExpected = 0;
+    unsigned _inTicks = 0;          // Local ticks when its header arrived
+
+    int _playerId = 0;
+    int _players = 1;
+    uint32_t _lastReceived = 0;     // Session clock of the last link transfer
+    uint32_t _nextSync = 0;
+    int _syncs = 0;
+    int _slewTicks = 0;             // Error still to be slewed into the timebase
+
+    // Leader state sent last, a change sends a FULL packet
+    bool _fullDue = true;
+    int _sentStatus = -1;
+    int _sentSessions = -1;
+    uint16_t _sentHash = 0;
+    int _lastRemaining = 0;
+
+    void lead(PomodoroContext& ctx, bool syncDue);
+
+    // Add a word from the leader, returns true once it completes a packet
+    bool receive(uint16_t word, unsigned now);
+    bool follow(PomodoroContext& ctx, unsigned now);
+    void pack(PomodoroContext& ctx, int type);
+};
+
+#else
+
+class LinkSync {
+public:
+    bool update(PomodoroContext&) {
+        return false;
+    }
+};
+
+#endif
+
+#endif
@@ -4,608 +4,593 @@
  * Implemented using Butano engine
  */
 #include "bn_core.h"
-#include "bn_timer.h"
 #include "bn_keypad.h"
-#include "bn_string.h"
-#include "bn_string_view.h"
-#include "bn_timers.h"
-#include "bn_bg_palettes.h"
-#include "bn_sprite_text_generator.h"
+#include "bn_span.h"
 
 #include "common_info.h"
 #include "common_variable_8x16_sprite_font.h"
 
-// Pomodoro States
-enum class PomodoroState {
-    IDLE,
-    WORK,
-    SHORT_BREAK,
-    LONG_BREAK,
-    CONFIG
-};
+#include "pomodoro.h"
+#include "bg_font.h"
+#include "perf_hud.h"
+#include "save_store.h"
+#include "session_history.h"
+#include "reminders.h"
+#include "psg_audio.h"
+#include "wall_clock.h"
+#include "input_trace.h"
+#include "soak_test.h"
+#include "link_sync.h"
+#include "backdrop.h"
+#include "screen_chrome.h"
+#include "screen_transition.h"
+#include "render_schedule.h"
 
-// Pomodoro Configuration
-struct PomodoroConfig {
-    int workTime = 25 * 60;         // 25 minutes
-    int shortBreakTime = 5 * 60;    // 5 minutes
-    int longBreakTime = 15 * 60;    // 15 minutes
-    int sessionsPerSet = 4;         // 4 sessions before a long break
-    bn::color workColor = bn::color(31, 0, 0);     // Red
-    bn::color shortColor = bn::color(0, 31, 0);    // Green
-    bn::color longColor = bn::color(0, 0, 31);     // Blue
-};
+// Low-power idle: seconds without input while paused before the console is put
+// to sleep (0 disables it). Press START to wake up. Input trace and soak test
+// runs never sleep.
+#ifndef POMI_IDLE_SLEEP_SECONDS
+    #define POMI_IDLE_SLEEP_SECONDS 300
+#endif
 
-// Pomodoro Context
-struct PomodoroContext {
-    PomodoroConfig config;
-    PomodoroState state = PomodoroState::IDLE;
-    int secondsRemaining = 0;
-    int completedSessions = 0;
-    int completedSets = 0;
-    bool timerActive = false;
-    int configSelection = 0;
-    bn::timer timer;
-    long long lastTicks = 0;  // Use long long instead of uint64_t
-};
-
-// Screen dimensions
-constexpr int SCREEN_WIDTH = 240;
-constexpr int SCREEN_HEIGHT = 160;
-constexpr int SCREEN_CENTER_X = SCREEN_WIDTH / 2;
-constexpr int SCREEN_CENTER_Y = SCREEN_HEIGHT / 2;
-
-// Function declarations
-void changeState(PomodoroContext& ctx, PomodoroState newState);
-void drawProgressBar(bn::sprite_text_generator& text_generator, bn::vector<bn::sprite_ptr, 128>& sprites, 
-                   int current, int total, bn::color color);
-void handleInput(PomodoroContext& ctx);
-void updateTimer(PomodoroContext& ctx);
-void renderPomodoro(PomodoroContext& ctx, bn::sprite_text_generator& text_generator, 
-                  bn::vector<bn::sprite_ptr, 128>& sprites);
-void renderTimer(PomodoroContext& ctx, bn::sprite_text_generator& text_generator, 
-                bn::vector<bn::sprite_ptr, 128>& sprites);
-void renderConfig(PomodoroContext& ctx, bn::sprite_text_generator& text_generator, 
-                bn::vector<bn::sprite_ptr, 128>& sprites);
-void playSound(int frequency, int duration);
-void renderTimerText(bn::sprite_text_generator& text_generator, bn::vector<bn::sprite_ptr, 128>& sprites, long long seconds);
-void drawHorizontalLine(bn::sprite_text_generator& text_generator, bn::vector<bn::sprite_ptr, 128>& sprites,
-                      int y, int width, bn::color color);
-void drawVerticalLine(bn::sprite_text_generator& text_generator, bn::vector<bn::sprite_ptr, 128>& sprites,
-                     int x, int y1, int y2, bn::color color);
-void drawPanel(bn::sprite_text_generator& text_generator, bn::vector<bn::sprite_ptr, 128>& sprites,
-              int x, int y, int width, int height, bn::color color, const bn::string_view& title);
+constexpr uint32_t IDLE_SLEEP_SECONDS = INPUT_TRACE || SOAK_TEST ? 0 : POMI_IDLE_SLEEP_SECONDS;
 
+#if !POMI_BENCHMARK
 int main()
 {
     // Initialize the Butano engine
     bn::core::init();
     
+    // Sound effects use the DMG PSG channels, whatever the audio backend
+    initAudio();
+    
     // Game setup
     bn::sprite_text_generator text_generator(common::variable_8x16_sprite_font);
-    bn::vector<bn::sprite_ptr, 128> text_sprites;
     text_generator.set_center_alignment();
     
-    // Set background color to dark blue for space-like feel
-    bn::bg_palettes::set_transparent_color(bn::color(0, 0, 8)); // Very dark blue
-    
     // Initialize Pomodoro context
     PomodoroContext ctx;
-    ctx.secondsRemaining = ctx.config.workTime;
     ctx.state = PomodoroState::WORK;  // Set initial state to WORK instead of default IDLE
     
+    // Restore the saved config and counters (defaults if there is no valid save).
+    // Input trace runs always start from the defaults, so that they replay alike
+    bool restore = !INPUT_TRACE;
+    SaveStore saveStore;
+    
+    if (restore) {
+        saveStore.load(ctx);
+    }
+    
+    ctx.secondsRemaining = stateDuration(ctx);
+    
+    // Finished intervals are appended to a ring buffer in SRAM
+    SessionHistory history;
+    
+    // Resume the session clock from the last record, follow the cartridge RTC
+    // if there is one, then continue the interval saved at the last checkpoint
+    if (restore) {
+        history.load(ctx);
+        syncWallClock(ctx);
+        saveStore.resume(ctx);
+    }
+    
+    armReminders(ctx);
+    
+    // Recorded or replayed input, a pass-through unless built with
+    // POMI_INPUT_RECORD or POMI_INPUT_REPLAY
+    InputTrace inputTrace;
+    inputTrace.begin();
+    
+    // Time-warped self-driving run with invariant checks, empty unless built
+    // with POMI_TIME_WARP
+    SoakTest soakTest;
+    soakTest.begin(ctx);
+    
+    // Key presses and held direction repeats, consumed by handleInput
+    InputEvents inputEvents;
+    
+    // Static text is written into a background map instead of sprites
+    BgText bgText;
+    
+    // Gradient sky behind everything, written per scanline by HDMA
+    Backdrop backdrop(ctx.state);
+    
+    // State colors are applied by rewriting the accent palette entries
+    StateTheme theme(common::variable_8x16_sprite_font.item().palette_item(), stateColor(ctx));
+    
+    // Sprites are taken from a persistent pool and hidden when released
+    SpritePool spritePool;
+    
+    // Retained screens: each element keeps its sprites between frames
+    PomodoroScreen pomodoroScreen(text_generator, theme, spritePool);
+    ConfigScreen configScreen;
+    StatsScreen statsScreen;
+    
+    // Screen switches are built over a few frames behind the screen on display
+    ScreenTransition transition;
+    
+    // Debug overlay, empty unless built with POMI_PERF_HUD
+    PerfHud perfHud;
+    
+    // Link cable group mode, empty unless built with POMI_LINK
+    LinkSync linkSync;
+    
+    // The render stage only runs when something on screen is out of date,
+    // at most at POMI_RENDER_HZ unless it follows input
+    RenderSchedule renderSchedule;
+    ChangeKey sleepKey;
+    
     // Main game loop
     while(true)
     {
-        // Handle user input
-        handleInput(ctx);
+        // The transition budget counts the whole frame, from here
+        transition.beginFrame();
         
-        // Update timer
-        updateTimer(ctx);
-        
-        // Clear previous text sprites and create new empty vector for this frame
-        text_sprites = bn::vector<bn::sprite_ptr, 128>();
-        
-        // Render appropriate screen based on current state
-        if(ctx.state == PomodoroState::CONFIG) {
-            renderConfig(ctx, text_generator, text_sprites);
-        } else {
-            renderPomodoro(ctx, text_generator, text_sprites);
-        }
+        // Handle user input (the performance HUD toggle combo is consumed first).
+        // The trace sees every frame, so that replayed ticks keep going
+        bool hudToggled = perfHud.handleToggle();
+        KeyInput keys = soakTest.frame(ctx, inputTrace.frame(hudToggled ? KeyInput() : readKeys()));
+        inputEvents.fill(keys);
+        bool input = handleInput(ctx, inputEvents) || hudToggled;
         
-        // Process frame and wait for next
-        bn::core::update();
-    }
-}
-
-// Update the timer state
-void updateTimer(PomodoroContext& ctx) {
-    // Only update if timer is active
-    if (!ctx.timerActive) {
-        return;
-    }
-    
-    // Get elapsed time
-    long long currentTicks = ctx.timer.elapsed_ticks();
-    long long elapsedTicks = currentTicks - ctx.lastTicks;
-    
-    // Convert to seconds using Butano's utility
-    if (elapsedTicks >= bn::timers::ticks_per_second()) {
-        // Calculate how many seconds have elapsed
-        int elapsedSeconds = elapsedTicks / bn::timers::ticks_per_second();
+        // Update timer
+        bool ticked = updateTimer(ctx);
         
-        // Decrease the remaining time
-        ctx.secondsRemaining -= elapsedSeconds;
+        // The group leader broadcasts its timer, followers lock theirs to it
+        bool synced = linkSync.update(ctx);
         
-        // Update the last tick count
-        ctx.lastTicks = currentTicks;
+        // Record the interval that ended this frame, if any
+        soakTest.check(ctx);
+        history.update(ctx);
         
-        // Check if timer has ended
-        if (ctx.secondsRemaining <= 0) {
-            // Timer finished
-            ctx.timerActive = false;
-            ctx.secondsRemaining = 0;
-            
-            // Play sound to alert user
-            playSound(440, 30); // A4 note
-            
-            // Switch to next state
-            // If we're in a work session, track completion
-            if (ctx.state == PomodoroState::WORK) {
-                ctx.completedSessions++;
-                
-                // Check if we've completed a full set
-                if (ctx.completedSessions % ctx.config.sessionsPerSet == 0) {
-                    ctx.completedSets++;
-                    changeState(ctx, PomodoroState::LONG_BREAK);
-                } else {
-                    changeState(ctx, PomodoroState::SHORT_BREAK);
-                }
-            } else if (ctx.state == PomodoroState::SHORT_BREAK || 
-                     ctx.state == PomodoroState::LONG_BREAK) {
-                // After a break, go back to work
-                changeState(ctx, PomodoroState::WORK);
-            }
-        }
-    }
-}
-
-// Handle user input
-void handleInput(PomodoroContext& ctx) {
-    if (ctx.state == PomodoroState::CONFIG) {
-        // Configuration mode input handling
+        // Coalesced SRAM writes: only on state transitions or config menu inactivity
+        saveStore.update(ctx, input);
+        soakTest.checkSaved(ctx, history);
         
-        // Navigate configuration options
-        if (bn::keypad::up_pressed()) {
-            if (ctx.configSelection > 0) {
-                ctx.configSelection--;
+        // The idle sleep deadline is only moved by input or by the timer starting or stopping
+        if (IDLE_SLEEP_SECONDS > 0 && (sleepKey.changed(ctx.timerActive) || input)) {
+            if (ctx.timerActive) {
+                ctx.deadlines.cancel(DeadlineId::IDLE_SLEEP);
             } else {
-                ctx.configSelection = 3; // Wrap to last option (we now have only 4 options)
+                ctx.deadlines.schedule(DeadlineId::IDLE_SLEEP, ctx.clockSeconds + IDLE_SLEEP_SECONDS);
             }
         }
         
-        if (bn::keypad::down_pressed()) {
-            if (ctx.configSelection < 3) { // Now only 4 options (0-3)
-                ctx.configSelection++;
+        // Reminders and idle sleep: only the earliest deadline is compared
+        // against the session clock, however many events are scheduled
+        bool sleepDue = false;
+        DeadlineId due;
+        
+        while (ctx.deadlines.popDue(ctx.clockSeconds, due)) {
+            if (due == DeadlineId::IDLE_SLEEP) {
+                sleepDue = true;
             } else {
-                ctx.configSelection = 0; // Wrap to first option
+                fireReminder(ctx, due);
+                renderSchedule.invalidate();
             }
         }
         
-        // Adjust values
-        int change = 0;
-        if (bn::keypad::left_pressed()) {
-            change = -1;
-        }
-        if (bn::keypad::right_pressed()) {
-            change = 1;
+        // Input redraws at once, and a screen switch and its fade are finished
+        // at the full frame rate. Ticks and everything else are rate limited; the
+        // progress bar of a running timer and palette fades move on every render
+        ScreenId target = ctx.state == PomodoroState::CONFIG ? ScreenId::CONFIG :
+                          ctx.state == PomodoroState::STATS ? ScreenId::STATS : ScreenId::POMODORO;
+        
+        if (input || transition.building() || transition.fading() || transition.target() != target) {
+            renderSchedule.invalidate(true);
+        } else if (ticked || synced || ctx.timerActive || theme.fading()) {
+            renderSchedule.invalidate();
         }
         
-        if (change != 0) {
-            // Apply change to the selected config item
-            switch (ctx.configSelection) {
-                case 0: // Work time
-                    ctx.config.workTime += change * 60;
-                    if (ctx.config.workTime < 60) {
-                        ctx.config.workTime = 60;  // Minimum 1 minute
+        // Render stage, skipped entirely when nothing is dirty
+        if (renderSchedule.due()) {
+            perf::countRender();
+            
+            // A new screen is built in stages behind the one on display: chrome,
+            // then fields, then the swap of sprites and map. Stages stop for the
+            // frame once it has used its share of CPU time, unless none ran yet
+            transition.setTarget(target, bgText);
+            TransitionStage stage;
+            
+            while (transition.nextStage(stage, bgText)) {
+                if (stage == TransitionStage::CHROME) {
+                    // The BG text is built from scratch, even if the target is still
+                    // the screen on display. Its sprites stay up until the swap
+                    if (target == ScreenId::CONFIG) {
+                        configScreen.release();
+                        configScreen.show(bgText);
+                    } else if (target == ScreenId::STATS) {
+                        statsScreen.release();
+                        statsScreen.show(bgText);
+                    } else {
+                        pomodoroScreen.invalidate();
+                        pomodoroScreen.show(bgText);
                     }
-                    break;
-                case 1: // Short break
-                    ctx.config.shortBreakTime += change * 60;
-                    if (ctx.config.shortBreakTime < 60) {
-                        ctx.config.shortBreakTime = 60;  // Minimum 1 minute
+                } else if (stage == TransitionStage::FIELDS) {
+                    if (target == ScreenId::CONFIG) {
+                        renderConfig(ctx, bgText, configScreen);
+                    } else if (target == ScreenId::STATS) {
+                        renderStats(ctx, bgText, statsScreen);
+                    } else {
+                        renderPomodoro(ctx, bgText, pomodoroScreen);
                     }
-                    break;
-                case 2: // Long break
-                    ctx.config.longBreakTime += change * 60;
-                    if (ctx.config.longBreakTime < 60) {
-                        ctx.config.longBreakTime = 60;  // Minimum 1 minute
+                } else {
+                    if (target != ScreenId::POMODORO) {
+                        pomodoroScreen.release();
+                    }
+                    
+                    if (target != ScreenId::CONFIG) {
+                        configScreen.release();
                     }
-                    break;
-                case 3: // Sessions per set
-                    ctx.config.sessionsPerSet += change;
-                    if (ctx.config.sessionsPerSet < 1) {
-                        ctx.config.sessionsPerSet = 1;  // Minimum 1 session
+                    
+                    if (target != ScreenId::STATS) {
+                        statsScreen.release();
                     }
-                    break;
+                    
+                    if (target == ScreenId::POMODORO) {
+                        pomodoroScreen.refresh(text_generator);
+                    }
+                }
             }
-        }
-        
-        // Exit config mode
-        if (bn::keypad::b_pressed() || bn::keypad::select_pressed()) {
-            changeState(ctx, PomodoroState::IDLE);
-        }
-    } else {
-        // Normal operation mode input handling
-        
-        // Toggle timer
-        if (bn::keypad::a_pressed()) {
-            ctx.timerActive = !ctx.timerActive;
             
-            // If starting timer, reset tick counter
-            if (ctx.timerActive) {
-                ctx.lastTicks = ctx.timer.elapsed_ticks();
+            // Render the screen on display, right after the swap too so it catches
+            // up with whatever changed while building. Only elements whose inputs
+            // changed are regenerated.
+            if (!transition.building()) {
+                if (target == ScreenId::CONFIG) {
+                    renderConfig(ctx, bgText, configScreen);
+                } else if (target == ScreenId::STATS) {
+                    renderStats(ctx, bgText, statsScreen);
+                } else {
+                    renderPomodoro(ctx, bgText, pomodoroScreen);
+                    pomodoroScreen.refresh(text_generator);
+                }
             }
-        }
-        
-        // Reset timer
-        if (bn::keypad::b_pressed()) {
-            ctx.timerActive = false;
-            // Reset the tick counter
-            ctx.lastTicks = ctx.timer.elapsed_ticks();
             
-            // Reset to appropriate duration based on current state
-            if (ctx.state == PomodoroState::WORK) {
-                ctx.secondsRemaining = ctx.config.workTime;
-            } else if (ctx.state == PomodoroState::SHORT_BREAK) {
-                ctx.secondsRemaining = ctx.config.shortBreakTime;
-            } else if (ctx.state == PomodoroState::LONG_BREAK) {
-                ctx.secondsRemaining = ctx.config.longBreakTime;
-            } else {
-                ctx.secondsRemaining = ctx.config.workTime;
+            // Theme changes only cost palette writes (faded in over a few frames)
+            // and a backdrop table swap, made once the new screen is on display
+            if (!transition.building()) {
+                theme.setAccent(stateColor(ctx), RENDER_FADES);
+                backdrop.setState(ctx.state);
+            }
+            
+            // The progress bar edge moves smoothly between second ticks
+            if (target == ScreenId::POMODORO && !transition.building()) {
+                renderProgress(ctx, pomodoroScreen);
             }
+            
+            theme.update(bgText);
         }
         
-        // Enter config mode
-        if (bn::keypad::select_pressed()) {
-            ctx.timerActive = false;
-            changeState(ctx, PomodoroState::CONFIG);
+        perfHud.update(bgText);
+        bgText.commit();
+        
+        // Sleep after a long inactivity period while paused. Reminders count
+        // again from the wake up
+        if (sleepDue) {
+            saveStore.flush(ctx);
+            bn::core::sleep(bn::keypad::key_type::START);
+            syncWallClock(ctx);
+            armReminders(ctx);
+            ctx.deadlines.schedule(DeadlineId::IDLE_SLEEP, ctx.clockSeconds + IDLE_SLEEP_SECONDS);
         }
+        
+        // Start the next notes of a chime, if one is playing
+        updateAudio();
+        
+        // Process frame and wait for next (the CPU is halted until VBlank)
+        bn::core::update();
     }
 }
 
-// Render the Pomodoro timer screen
-void renderPomodoro(PomodoroContext& ctx, bn::sprite_text_generator& text_generator,
-                  bn::vector<bn::sprite_ptr, 128>& sprites) {
-    bn::color stateColor;
-    bn::string_view stateText;
-    
-    // Determine state color and text based on current state and timer activity
-    if (ctx.state == PomodoroState::WORK) {
-        stateColor = ctx.config.workColor;
-        stateText = ctx.timerActive ? "WORK" : "WORK - PAUSED";
-    } else if (ctx.state == PomodoroState::SHORT_BREAK) {
-        stateColor = ctx.config.shortColor;
-        stateText = ctx.timerActive ? "SHORT REST" : "SHORT REST - PAUSED";
-    } else if (ctx.state == PomodoroState::LONG_BREAK) {
-        stateColor = ctx.config.longColor;
-        stateText = ctx.timerActive ? "LONG REST" : "LONG REST - PAUSED";
-    } else {
-        stateColor = bn::color(31, 31, 31);
-        stateText = "STANDBY";
+#endif
+
+// Render the BG text of the Pomodoro timer screen and set the inputs of its
+// sprites, PomodoroScreen::refresh() then regenerates the ones that changed
+void renderPomodoro(PomodoroContext& ctx, BgText& bgText, PomodoroScreen& screen) {
+    screen.show(bgText);
+    
+    // State text depends on the current state and timer activity
+    if (screen.stateLabel.changed(static_cast<int>(ctx.state) * 2 + ctx.timerActive)) {
+        const StateDescriptor& descriptor = stateDescriptor(ctx.state);
+        screen.stateLabel.setText(ctx.timerActive ? descriptor.label : descriptor.pausedLabel);
     }
     
-    // Set center alignment for all text
-    text_generator.set_center_alignment();
-    
-    // Draw title
-    text_generator.generate(0, -70, "POMI", sprites);
-    
-    // Draw state panel with minimal decorations
-    drawPanel(text_generator, sprites, 0, -20, 160, 50, stateColor, "STATUS");
+    // Timer display (centered on screen), only changed digits are updated
+    screen.countdown.setSeconds(ctx.secondsRemaining);
     
-    // Draw current state
-    text_generator.generate(0, -40, stateText, sprites);
-    
-    // Render timer display (centered on screen)
-    renderTimerText(text_generator, sprites, ctx.secondsRemaining);
+    // Session counter, next to its precomposed label
+    if (screen.cyclesKey.changed(ctx.completedSessions)) {
+        bn::string<8> cyclesText = bn::to_string<8>(ctx.completedSessions);
+        bgText.fill(PomodoroScreen::VALUE_COLUMN, PomodoroScreen::CYCLES_ROW,
+                    BG_TEXT_COLUMNS - PomodoroScreen::VALUE_COLUMN, ' ');
+        bgText.write(PomodoroScreen::VALUE_COLUMN, PomodoroScreen::CYCLES_ROW, cyclesText);
+    }
     
-    // Draw stats with balanced spacing
-    text_generator.generate(-5, 20, "CYCLES:", sprites);
+    // Dynamic command text based on timer state (both variants have the same length)
+    if (screen.commandLineKey.changed(ctx.timerActive)) {
+        bgText.writeCentered(PomodoroScreen::COMMAND_LINE_ROW, ctx.timerActive ? "Pause:A Reset:B Config:SELECT" :
+                                                                               "Start:A Reset:B Config:SELECT");
+    }
     
-    // Display session counter
-    bn::string<8> sessionText = bn::to_string<4>(ctx.completedSessions);
-    text_generator.generate(25, 20, sessionText, sprites);
+    // Reminder alert, shown until its clear deadline
+    if (screen.alertKey.changed(ctx.reminderAlert)) {
+        bgText.clearRow(PomodoroScreen::ALERT_ROW);
+        
+        if (ctx.reminderAlert >= 0) {
+            bgText.writeCentered(PomodoroScreen::ALERT_ROW, REMINDERS[ctx.reminderAlert].label, BgTextColor::ACCENT);
+        }
+    }
     
-    // Draw controls panel
-    drawPanel(text_generator, sprites, 0, 80, 160, 30, bn::color(0, 31, 31), "COMMANDS");
+    // Link cable group role and size
+    int groupKey = ctx.groupRole == GroupRole::SOLO ? 0 :
+                   static_cast<int>(ctx.groupRole) * 16 + ctx.groupPlayers * 2 + ctx.groupConfigMatch;
     
-    // Create dynamic command text based on timer state
-    bn::string<64> commandText;
-    if (ctx.timerActive) {
-        commandText = "Pause:A Reset:B Config:SELECT";
-    } else {
-        commandText = "Start:A Reset:B Config:SELECT";
+    if (screen.groupKey.changed(groupKey)) {
+        bgText.fill(PomodoroScreen::GROUP_COLUMN, PomodoroScreen::TITLE_ROW, 6, ' ');
+        
+        if (ctx.groupRole != GroupRole::SOLO) {
+            bn::string<8> groupText = ctx.groupRole == GroupRole::LEADER ? "LEAD " :
+                                      ctx.groupConfigMatch ? "SYNC " : "CFG? ";
+            groupText.append(COUNT_LABELS[ctx.groupPlayers]);
+            bgText.write(PomodoroScreen::GROUP_COLUMN, PomodoroScreen::TITLE_ROW, groupText);
+        }
     }
-    
-    // Show controls with proper spacing
-    text_generator.generate(0, 70, commandText, sprites);
+}
+
+// Update the progress bar, one window edge write at most
+void renderProgress(PomodoroContext& ctx, PomodoroScreen& screen) {
+    int total = stateDuration(ctx);
+    int fraction = 0;
+    
+#if !POMI_HW_SECONDS
+    // A paused timer keeps its remainder until it resumes, so the edge stays
+    // where it stopped. Resets and transitions clear it
+    fraction = ctx.timebase.remainderFraction();
+#endif
+    
+    screen.progress.setProgress(total - ctx.secondsRemaining, fraction, total);
 }
 
 // Render the configuration menu
-void renderConfig(PomodoroContext& ctx, bn::sprite_text_generator& text_generator,
-                bn::vector<bn::sprite_ptr, 128>& sprites) {
-    // Create new empty vector to replace the current one
-    sprites = bn::vector<bn::sprite_ptr, 128>();
+void renderConfig(PomodoroContext& ctx, BgText& bgText, ConfigScreen& screen) {
+    screen.show(bgText);
     
-    // Ensure center alignment
-    text_generator.set_center_alignment();
-    
-    // Draw title
-    text_generator.generate(0, -70, "CONFIG", sprites);
-    
-    // Draw simplified config panel
-    drawPanel(text_generator, sprites, 0, 0, 160, 100, bn::color(0, 31, 31), "PARAMS");
-    
-    // Define simplified config items
-    const char* item_labels[] = {
-        "WORK:", "S.REST:", "L.REST:", "SET SIZE:"
+    const int item_values[] = {
+        ctx.config.workTime, ctx.config.shortBreakTime, ctx.config.longBreakTime, ctx.config.sessionsPerSet
     };
     
-    // Display only 4 key config items
+    // Move the selection indicator
+    if (screen.cursorKey.changed(ctx.configSelection)) {
+        bgText.write(ConfigScreen::CURSOR_COLUMN, screen.cursorRow, " ");
+        screen.cursorRow = ConfigScreen::ITEM_ROWS[ctx.configSelection];
+        bgText.write(ConfigScreen::CURSOR_COLUMN, screen.cursorRow, ">");
+    }
+    
+    // Display only 4 key config items, rewriting just the ones that changed
     for (int i = 0; i < 4; ++i) {
-        bn::string<24> itemText = item_labels[i];
-        
-        // Show selection indicator
-        if (ctx.configSelection == i) {
-            text_generator.generate(-75, -40 + i * 20, ">", sprites);
+        if (!screen.itemKeys[i].changed(item_values[i])) {
+            continue;
         }
         
-        // Add value for each item
-        switch (i) {
-            case 0: // Work time
-                itemText.append(bn::to_string<4>(ctx.config.workTime / 60));
-                itemText.append("m");
-                break;
-            case 1: // Short break
-                itemText.append(bn::to_string<4>(ctx.config.shortBreakTime / 60));
-                itemText.append("m");
-                break;
-            case 2: // Long break
-                itemText.append(bn::to_string<4>(ctx.config.longBreakTime / 60));
-                itemText.append("m");
-                break;
-            case 3: // Sessions per set
-                itemText.append(bn::to_string<4>(ctx.config.sessionsPerSet));
-                break;
-        }
+        // Values come from the precomputed labels, the item labels are part of the chrome
+        bn::string_view valueText = i < 3 ? MINUTE_LABELS[splitClock(item_values[i]).minutes] :
+                                            COUNT_LABELS[item_values[i]];
         
-        // Display the item
-        text_generator.generate(0, -40 + i * 20, itemText, sprites);
+        bgText.fill(ConfigScreen::VALUE_COLUMN, ConfigScreen::ITEM_ROWS[i], ConfigScreen::VALUE_CELLS, ' ');
+        bgText.write(ConfigScreen::VALUE_COLUMN, ConfigScreen::ITEM_ROWS[i], valueText);
+    }
+}
+
+// Write the static text of the timer screen when it is shown
+void PomodoroScreen::show(BgText& bgText) {
+    if (shown) {
+        return;
     }
     
-    // Draw controls at bottom
-    text_generator.generate(0, 60, "NAVIGATE:\x18\x19 ADJUST:\x1A\x1B EXIT:B", sprites);
+    shown = true;
+    cyclesKey.invalidate();
+    commandLineKey.invalidate();
+    alertKey.invalidate();
+    groupKey.invalidate();
+    
+    bgText.load(POMODORO_CHROME);
+    progress.show(bgText);
+    stateLabel.setFallback(bgText);
 }
 
-// Draw a progress bar
-void drawProgressBar(bn::sprite_text_generator& text_generator, bn::vector<bn::sprite_ptr, 128>& sprites,
-                   int current, int total, bn::color color) {
-    // Calculate progress (0-100%)
-    int progress = total > 0 ? (current * 100) / total : 0;
-    
-    // Create a string_view for the blocks we'll use
-    bn::string_view full_block = "■";
-    bn::string_view empty_block = "□";
-    
-    // Draw the progress bar as a series of characters - use a larger buffer
-    bn::string<128> barText = "[";
-    
-    // Use different characters for a more futuristic look
-    for (int i = 0; i < 20; ++i) {
-        if (i * 5 < progress) {
-            barText.append(full_block);
-        } else {
-            barText.append(empty_block);
-        }
+// Regenerate the dirty sprite elements of the timer screen
+void PomodoroScreen::refresh(bn::sprite_text_generator& text_generator) {
+    stateLabel.refresh(text_generator);
+    countdown.setVisible(true);
+}
+
+// Rebuild the BG text on the next show(), leaving the sprites on display
+void PomodoroScreen::invalidate() {
+    shown = false;
+}
+
+// Free the sprites of the timer screen while another screen is shown
+void PomodoroScreen::release() {
+    stateLabel.release();
+    countdown.setVisible(false);
+    progress.hide();
+    shown = false;
+}
+
+// Write the static text of the configuration menu when it is shown
+void ConfigScreen::show(BgText& bgText) {
+    if (shown) {
+        return;
     }
-    barText.append("]");
     
-    // Draw the bar
-    text_generator.generate(0, 15, barText, sprites);
+    shown = true;
+    cursorKey.invalidate();
+    
+    for (ChangeKey& itemKey : itemKeys) {
+        itemKey.invalidate();
+    }
     
-    // Draw percentage
-    bn::string<16> percentText = bn::to_string<8>(progress);
-    percentText.append("%");
-    text_generator.generate(0, 30, percentText, sprites);
+    bgText.load(CONFIG_CHROME);
 }
 
-// Change the timer state
-void changeState(PomodoroContext& ctx, PomodoroState newState) {
-    // Store previous state for transition effects
-    PomodoroState oldState = ctx.state;
+// Forget the configuration menu text while another screen is shown
+void ConfigScreen::release() {
+    shown = false;
+}
+
+// Render the statistics screen: the statistics and the 7 day chart are
+// written once, the screen is static while it is open
+void renderStats(PomodoroContext& ctx, BgText& bgText, StatsScreen& screen) {
+    screen.show(bgText);
+    
+    if (screen.filled) {
+        return;
+    }
     
-    // Update state
-    ctx.state = newState;
+    screen.filled = true;
     
-    // Reset timer activity when changing states
-    if (oldState != newState && newState != PomodoroState::CONFIG) {
-        ctx.timerActive = false;
+    // Buckets as seen today, without touching the saved aggregates
+    uint32_t today = sessionDay(ctx.clockSeconds);
+    SessionStats stats = ctx.stats;
+    stats.roll(today);
+    
+    // Without a wall clock a day is a 24 hour period of the session clock,
+    // which doesn't start at midnight
+    if (!ctx.wallClock) {
+        bgText.clearRow(StatsScreen::CHART_HEADER_ROW);
+        bgText.writeCentered(StatsScreen::CHART_HEADER_ROW, "[ LAST 7 x 24H ]");
     }
     
-    // Set the new timer based on the state
-    switch (newState) {
-        case PomodoroState::WORK:
-            ctx.secondsRemaining = ctx.config.workTime;
-            break;
-        case PomodoroState::SHORT_BREAK:
-            ctx.secondsRemaining = ctx.config.shortBreakTime;
-            break;
-        case PomodoroState::LONG_BREAK:
-            ctx.secondsRemaining = ctx.config.longBreakTime;
-            break;
-        default:
-            // For IDLE or CONFIG, use the work time as default
-            ctx.secondsRemaining = ctx.config.workTime;
-            break;
+    bn::string<32> line = ctx.wallClock ? "TODAY: " : "THIS 24H: ";
+    line.append(bn::to_string<8>(stats.dayFocusSeconds[0] / 60));
+    line.append(" MIN FOCUS");
+    bgText.writeCentered(StatsScreen::TODAY_ROW, line);
+    
+    line = "STREAK: ";
+    line.append(bn::to_string<8>(stats.streak(today)));
+    line.append(ctx.wallClock ? " DAYS  BEST: " : " x 24H  BEST: ");
+    line.append(bn::to_string<8>(stats.bestStreak));
+    bgText.writeCentered(StatsScreen::STREAK_ROW, line);
+    
+    int tenths = stats.interruptionsPerSessionTenths();
+    line = "INTERRUPTS: ";
+    line.append(bn::to_string<8>(tenths / 10));
+    line.append('.');
+    line.append(COUNT_LABELS[tenths % 10]);
+    line.append(" / SESSION");
+    bgText.writeCentered(StatsScreen::INTERRUPTIONS_ROW, line);
+    
+    // Bars are scaled to the busiest day, in eighths of a cell
+    uint32_t maxSeconds = 0;
+    
+    for (uint32_t seconds : stats.dayFocusSeconds) {
+        if (seconds > maxSeconds) {
+            maxSeconds = seconds;
+        }
     }
     
-    // Play transition sound
-    if (oldState != newState) {
-        // Different sounds for different transitions
-        if (newState == PomodoroState::WORK) {
-            playSound(1500, 20);
-        } else if (newState == PomodoroState::SHORT_BREAK || newState == PomodoroState::LONG_BREAK) {
-            playSound(800, 20);
-        } else if (newState == PomodoroState::IDLE) {
-            playSound(500, 10);
+    constexpr int CHART_ROWS = StatsScreen::CHART_ROWS;
+    constexpr int CHART_TOP_ROW = StatsScreen::CHART_TOP_ROW;
+    constexpr int CHART_LEVELS = CHART_ROWS * BG_FONT_BAR_LEVELS;
+    constexpr int BAR_SPACING = 2;
+    constexpr int firstColumn = (BG_TEXT_COLUMNS - STATS_DAYS * BAR_SPACING) / 2 + 1;
+    
+    for (int index = 0; index < STATS_DAYS; ++index) {
+        // Oldest day on the left, today on the right
+        uint32_t seconds = stats.dayFocusSeconds[STATS_DAYS - 1 - index];
+        int column = firstColumn + index * BAR_SPACING;
+        int levels = maxSeconds ? int((seconds * CHART_LEVELS + maxSeconds - 1) / maxSeconds) : 0;
+        
+        for (int row = CHART_TOP_ROW + CHART_ROWS - 1; row >= CHART_TOP_ROW && levels > 0; --row) {
+            int cellLevels = levels < BG_FONT_BAR_LEVELS ? levels : BG_FONT_BAR_LEVELS;
+            bgText.fill(column, row, 1, char(cellLevels), BgTextColor::ACCENT);
+            levels -= cellLevels;
         }
+        
+        bgText.fill(column, StatsScreen::CHART_LABEL_ROW, 1, index == STATS_DAYS - 1 ? 'T' : char('0' + STATS_DAYS - 1 - index));
     }
+    
+    line = "TOP: ";
+    line.append(bn::to_string<8>(maxSeconds / 60));
+    line.append(" MIN");
+    bgText.writeCentered(StatsScreen::CHART_SCALE_ROW, line);
 }
 
-// Play a sound effect
-void playSound(int frequency, int duration) {
-    // Simple placeholder function
-    // In a real implementation, this would use Butano's audio features
-    (void)frequency;
-    (void)duration;
-}
-
-// Draw a horizontal line
-void drawHorizontalLine(bn::sprite_text_generator& text_generator, bn::vector<bn::sprite_ptr, 128>& sprites,
-                      int y, int width, bn::color color) {
-    int halfWidth = width / 2;
-    
-    // Create string for horizontal line
-    bn::string<128> line;
-    
-    // Fill with horizontal line characters - make sure we don't overflow
-    int maxChars = halfWidth > 126 ? 126 : halfWidth; // Leave room for null terminator
-    for (int i = 0; i < maxChars; ++i) {
-        line += "-";
+// Write the static text of the statistics screen when it is shown
+void StatsScreen::show(BgText& bgText) {
+    if (shown) {
+        return;
     }
     
-    // Center alignment for line
-    text_generator.set_center_alignment();
-    text_generator.generate(0, y, line, sprites);
-    text_generator.set_left_alignment();
+    shown = true;
+    filled = false;
+    bgText.load(STATS_CHROME);
 }
 
-// Draw a vertical line (simplified)
-void drawVerticalLine(bn::sprite_text_generator& text_generator, bn::vector<bn::sprite_ptr, 128>& sprites,
-                     int x, int y1, int y2, bn::color color) {
-    // Draw vertical line by stacking characters
-    for (int y = y1; y <= y2; y += 8) {
-        text_generator.generate(x, y, "|", sprites);
-    }
+// Forget the statistics text while another screen is shown
+void StatsScreen::release() {
+    shown = false;
 }
 
-// Draw a simplified panel with title
-void drawPanel(bn::sprite_text_generator& text_generator, bn::vector<bn::sprite_ptr, 128>& sprites,
-              int x, int y, int width, int height, bn::color color, const bn::string_view& title) {
-    // Just draw the title at the top of where the panel would be
-    if (!title.empty()) {
-        // Calculate the top border position
-        int topBorderY = y - height/2;
-        
-        // Draw a simple header
-        bn::string<32> header = "[ ";
-        header.append(title);
-        header.append(" ]");
-        
-        // Generate title at the top center of the panel using the provided x coordinate
-        text_generator.generate(x, topBorderY - 8, header, sprites);
-    }
+// Accent color of the current state
+bn::color stateColor(const PomodoroContext& ctx) {
+    const StateDescriptor& descriptor = stateDescriptor(ctx.state);
+    return descriptor.accent ? ctx.config.*descriptor.accent : descriptor.defaultAccent;
 }
 
-// Render timer text as MM:SS
-void renderTimerText(bn::sprite_text_generator& text_generator, bn::vector<bn::sprite_ptr, 128>& sprites, long long seconds) {
-    // Convert seconds to minutes and remaining seconds
-    int minutes = seconds / 60;
-    int remainingSecs = seconds % 60;
-    
-    // Format time as MM:SS
-    bn::string<8> timerText;
-    
-    // Add minutes
-    if (minutes < 10) {
-        timerText.append("0");
-    }
-    timerText.append(bn::to_string<2>(minutes));
+// Play one of the state machine sound effects
+void playSound(SoundId sound) {
+    // Chimes on the PSG channels: frequency (Hz), duration and delay after the previous note (frames)
+    static constexpr PsgNote WORK_START_NOTES[] = {
+        squareNote(PsgChannel::SQUARE1, 1047, 8),           // C6 E6 G6, rising
+        squareNote(PsgChannel::SQUARE1, 1319, 8, 6),
+        squareNote(PsgChannel::SQUARE1, 1568, 20, 6)
+    };
     
-    timerText.append(":");
+    static constexpr PsgNote BREAK_START_NOTES[] = {
+        squareNote(PsgChannel::SQUARE1, 784, 8),            // G5 E5 C5, falling
+        squareNote(PsgChannel::SQUARE1, 659, 8, 6),
+        squareNote(PsgChannel::SQUARE1, 523, 20, 6)
+    };
     
-    // Add seconds
-    if (remainingSecs < 10) {
-        timerText.append("0");
-    }
-    timerText.append(bn::to_string<2>(remainingSecs));
+    static constexpr PsgNote STANDBY_NOTES[] = {
+        squareNote(PsgChannel::SQUARE1, 500, 10),
+        noiseNote(2, 1, 4)                                  // Soft click
+    };
     
-    // Generate the sprite centered on screen
-    text_generator.generate(0, 0, timerText, sprites);
-}
-
-// Render the timer screen
-void renderTimer(PomodoroContext& ctx, bn::sprite_text_generator& text_generator, 
-                bn::vector<bn::sprite_ptr, 128>& sprites) {
-    // Use string_view for static UI text
-    bn::string_view title_text = "MISSION TIMER";
-    bn::string_view time_panel = "TIME";
-    bn::string_view progress_panel = "PROGRESS";
-    bn::string_view command_panel = "COMMAND";
-    
-    // Dynamically choose start/pause text based on timer state
-    bn::string_view start_text = ctx.timerActive ? "PAUSE: A" : "START: A";
-    bn::string_view reset_text = "RESET: B";
-    bn::string_view menu_text = "MENU: SELECT";
-    
-    // Create new empty vector to replace the current one
-    sprites = bn::vector<bn::sprite_ptr, 128>();
-    
-    // Draw title
-    text_generator.generate(0, -70, title_text, sprites);
-    
-    // Draw timer panel
-    drawPanel(text_generator, sprites, 0, -30, 100, 50, bn::color(0, 31, 31), time_panel);
-    
-    // Draw timer
-    renderTimerText(text_generator, sprites, ctx.secondsRemaining);
-    
-    // Draw progress panel
-    drawPanel(text_generator, sprites, 0, 25, 200, 40, bn::color(0, 31, 31), progress_panel);
-    
-    // Calculate total time based on current state
-    int totalTime = 0;
-    if (ctx.state == PomodoroState::WORK) {
-        totalTime = ctx.config.workTime;
-    } else if (ctx.state == PomodoroState::SHORT_BREAK) {
-        totalTime = ctx.config.shortBreakTime;
-    } else if (ctx.state == PomodoroState::LONG_BREAK) {
-        totalTime = ctx.config.longBreakTime;
-    } else {
-        totalTime = 1; // Prevent division by zero
-    }
+    static constexpr PsgNote TIMER_END_NOTES[] = {
+        squareNote(PsgChannel::SQUARE1, 880, 12),           // A5 over a held A4, three times
+        squareNote(PsgChannel::SQUARE2, 440, 60, 0, 1),
+        squareNote(PsgChannel::SQUARE1, 880, 12, 15),
+        squareNote(PsgChannel::SQUARE1, 880, 30, 15)
+    };
     
-    // Calculate elapsed time (total - remaining)
-    int elapsed = totalTime - ctx.secondsRemaining;
-    
-    // Draw progress bar with color based on state
-    bn::color progressColor = bn::color(31, 31, 31); // Default white
-    if (ctx.state == PomodoroState::WORK) {
-        progressColor = ctx.config.workColor;
-    } else if (ctx.state == PomodoroState::SHORT_BREAK) {
-        progressColor = ctx.config.shortColor;
-    } else if (ctx.state == PomodoroState::LONG_BREAK) {
-        progressColor = ctx.config.longColor;
-    }
+    static constexpr PsgNote REMINDER_NOTES[] = {
+        squareNote(PsgChannel::SQUARE2, 1000, 6),
+        squareNote(PsgChannel::SQUARE2, 1000, 6, 10)
+    };
     
-    // Draw progress bar with correct parameters
-    drawProgressBar(text_generator, sprites, elapsed, totalTime, progressColor);
+    // Indexed by SoundId
+    static constexpr bn::span<const PsgNote> sounds[] = {
+        bn::span<const PsgNote>(),      // NONE
+        WORK_START_NOTES,
+        BREAK_START_NOTES,
+        STANDBY_NOTES,
+        TIMER_END_NOTES,
+        REMINDER_NOTES
+    };
     
-    // Draw command panel
-    drawPanel(text_generator, sprites, 0, 75, 200, 30, bn::color(0, 31, 31), command_panel);
+    const bn::span<const PsgNote>& notes = sounds[static_cast<int>(sound)];
     
-    // Draw controls
-    text_generator.generate(-60, 75, start_text, sprites);
-    text_generator.generate(0, 75, reset_text, sprites);
-    text_generator.generate(60, 75, menu_text, sprites);
-}
\ No newline at end of file
+    if (!notes.empty()) {
+        playNotes(notes.data(), notes.size());
+    }
+}
+
+// Play a single tone on the first square channel, faded out by its envelope
+void playSound(int frequency, int duration) {
+    if (frequency > 64 && frequency <= 131072 && duration > 0) {
+        playNote(squareNote(PsgChannel::SQUARE1, frequency, duration));
+    }
+}
@@ -0,0 +1,124 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Performance HUD implementation
+ */
+#include "perf_hud.h"
+
+#if POMI_PERF_HUD
+
+#include "bn_core.h"
+#include "bn_log.h"
+#include "bn_keypad.h"
+#include "bn_string.h"
+#include "bn_sprites.h"
+#include "bn_sprite_tiles.h"
+#include "bn_sprite_palettes.h"
+
+#include "bg_text.h"
+#include "psg_audio.h"
+#include "sprite_pool.h"
+
+namespace perf {
+    int generateCalls = 0;
+    int renders = 0;
+    int spriteRefusals = 0;
+    int peakPoolSprites = 0;
+    int peakSpriteTiles = 0;
+}
+
+namespace {
+    constexpr int TOP_ROW = 0;
+    constexpr int BOTTOM_ROW = BG_TEXT_ROWS - 1;
+    
+    int percent(bn::fixed usage) {
+        return (usage * 100).right_shift_integer();
+    }
+}
+
+bool PerfHud::handleToggle() {
+    if (bn::keypad::select_pressed() && bn::keypad::l_held() && bn::keypad::r_held()) {
+        _visible = !_visible;
+        _clear = !_visible;
+        _frames = 0;
+        return true;
+    }
+    
+    return false;
+}
+
+void PerfHud::update(BgText& bgText) {
+    bn::fixed cpu = bn::core::last_cpu_usage();
+    int generateCalls = perf::generateCalls;
+    perf::generateCalls = 0;
+    
+    if (cpu > _peakCpu) {
+        _peakCpu = cpu;
+    }
+    
+    if (generateCalls > _peakGenerateCalls) {
+        _peakGenerateCalls = generateCalls;
+    }
+    
+    _cpuSum += cpu;
+    ++_frames;
+    
+    if (_clear) {
+        bgText.clearRow(TOP_ROW);
+        bgText.clearRow(BOTTOM_ROW);
+        _clear = false;
+    }
+    
+    // Redraw periodically so that screen switches can't wipe the overlay for long
+    if (_visible && _frames % REFRESH_FRAMES == 1) {
+        draw(bgText, cpu, generateCalls);
+    }
+    
+    if (_frames >= POMI_PERF_LOG_FRAMES) {
+        BN_LOG("perf cpu avg: ", percent(_cpuSum / _frames), "% peak: ", percent(_peakCpu),
+               "% sprites: ", bn::sprites::used_sprites_count(),
+               " generate peak: ", _peakGenerateCalls,
+               " renders: ", perf::renders, "/", _frames,
+               " sprite tiles: ", bn::sprite_tiles::used_tiles_count(),
+               " sprite colors: ", bn::sprite_palettes::used_colors_count(),
+               " pool peak: ", perf::peakPoolSprites, "/", SPRITE_POOL_SLOTS,
+               " tiles peak: ", perf::peakSpriteTiles,
+               " refused: ", perf::spriteRefusals,
+               " audio: ", AUDIO_BACKEND_NAME);
+        
+        _peakCpu = 0;
+        _cpuSum = 0;
+        _peakGenerateCalls = 0;
+        perf::renders = 0;
+        _frames = 0;
+    }
+}
+
+void PerfHud::draw(BgText& bgText, bn::fixed cpu, int generateCalls) {
+    bn::string<32> top = "CPU:";
+    top.append(bn::to_string<4>(percent(cpu)));
+    top.append("% PK:");
+    top.append(bn::to_string<4>(percent(_peakCpu)));
+    top.append("% GEN:");
+    top.append(bn::to_string<4>(generateCalls));
+    top.append(" RF:");
+    top.append(bn::to_string<4>(perf::spriteRefusals));
+    
+    // Wider than a row only with near-full VRAM; the log line has every value
+    bn::string<40> bottom = "SPR:";
+    bottom.append(bn::to_string<4>(bn::sprites::used_sprites_count()));
+    bottom.append(" TIL:");
+    bottom.append(bn::to_string<4>(bn::sprite_tiles::used_tiles_count()));
+    bottom.append(" PAL:");
+    bottom.append(bn::to_string<4>(bn::sprite_palettes::used_colors_count() / 16));
+    bottom.append(" HW:");
+    bottom.append(bn::to_string<4>(perf::peakPoolSprites));
+    bottom.append("/");
+    bottom.append(bn::to_string<4>(perf::peakSpriteTiles));
+    
+    bgText.clearRow(TOP_ROW);
+    bgText.write(0, TOP_ROW, top);
+    bgText.clearRow(BOTTOM_ROW);
+    bgText.write(0, BOTTOM_ROW, bottom);
+}
+
+#endif
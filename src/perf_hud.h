@@ -0,0 +1,117 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Performance HUD and mGBA log instrumentation.
+ *
+ * Only compiled in when POMI_PERF_HUD is set (add -DPOMI_PERF_HUD=1 and
+ * -DBN_CFG_LOG_ENABLED=true to USERFLAGS). Otherwise every hook below is an
+ * empty inline function, so release ROMs pay nothing.
+ *
+ * L+R+SELECT toggles the overlay. Counters are streamed to bn::log every
+ * POMI_PERF_LOG_FRAMES frames.
+ */
+#ifndef POMI_PERF_HUD_H
+#define POMI_PERF_HUD_H
+
+#ifndef POMI_PERF_HUD
+    #define POMI_PERF_HUD 0
+#endif
+
+#ifndef POMI_PERF_LOG_FRAMES
+    #define POMI_PERF_LOG_FRAMES 60
+#endif
+
+#if POMI_PERF_HUD
+    #include "bn_fixed.h"
+    #include "bn_sprite_tiles.h"
+#endif
+
+class BgText;
+
+namespace perf {
+#if POMI_PERF_HUD
+    extern int generateCalls;
+    extern int renders;
+    extern int spriteRefusals;
+    extern int peakPoolSprites;
+    extern int peakSpriteTiles;
+
+    // Count a sprite text generator call
+    inline void countGenerate() {
+        ++generateCalls;
+    }
+
+    // Count a frame that ran the render stage
+    inline void countRender() {
+        ++renders;
+    }
+
+    // Count a sprite refused by the pool budget
+    inline void countSpriteRefusal() {
+        ++spriteRefusals;
+    }
+
+    // Update the sprite high-water marks, call right after allocating
+    inline void noteSpriteUsage(int poolSprites) {
+        int tiles = bn::sprite_tiles::used_tiles_count();
+
+        if (poolSprites > peakPoolSprites) {
+            peakPoolSprites = poolSprites;
+        }
+
+        if (tiles > peakSpriteTiles) {
+            peakSpriteTiles = tiles;
+        }
+    }
+#else
+    inline void countGenerate() {
+    }
+
+    inline void countRender() {
+    }
+
+    inline void countSpriteRefusal() {
+    }
+
+    inline void noteSpriteUsage(int) {
+    }
+#endif
+}
+
+#if POMI_PERF_HUD
+
+class PerfHud {
+public:
+    // Returns true if the toggle combo was pressed (the input is consumed)
+    bool handleToggle();
+
+    // Sample this frame's counters, call once per frame before bn::core::update
+    void update(BgText& bgText);
+
+private:
+    static constexpr int REFRESH_FRAMES = 16;
+
+    bn::fixed _peakCpu;
+    bn::fixed _cpuSum;
+    int _peakGenerateCalls = 0;
+    int _frames = 0;
+    bool _visible = false;
+    bool _clear = false;
+
+    void draw(BgText& bgText, bn::fixed cpu, int generateCalls);
+};
+
+#else
+
+class PerfHud {
+public:
+    bool handleToggle() {
+        return false;
+    }
+
+    void update(BgText&) {
+    }
+};
+
+#endif
+
+#endif
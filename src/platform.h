@@ -0,0 +1,154 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Clock and input interfaces of the timer core.
+ *
+ * The core only reads ticks through TickClock::elapsed_ticks() and keys
+ * through KeyInput. On the GBA they wrap bn::timer and bn::keypad; the host
+ * build (POMI_HOST, see host/Makefile) drives a simulated tick counter and
+ * synthetic key presses instead, POMI_INPUT_REPLAY builds the ticks of a
+ * recorded trace, and POMI_TIME_WARP soak test builds speed the ticks up.
+ */
+#ifndef POMI_PLATFORM_H
+#define POMI_PLATFORM_H
+
+#include <cstdint>
+
+// Set by the host build
+#ifndef POMI_HOST
+    #define POMI_HOST 0
+#endif
+
+// Input trace builds, see input_trace.h
+#ifndef POMI_INPUT_RECORD
+    #define POMI_INPUT_RECORD 0
+#endif
+
+#ifndef POMI_INPUT_REPLAY
+    #define POMI_INPUT_REPLAY 0
+#endif
+
+// Soak test builds, see soak_test.h (0 is off)
+#ifndef POMI_TIME_WARP
+    #define POMI_TIME_WARP 0
+#endif
+
+#if !POMI_HOST
+    #include "bn_timer.h"
+    #include "bn_timers.h"
+    #include "bn_keypad.h"
+#endif
+
+// Keys pressed this frame and directions held down, in KEYINPUT bit order
+struct KeyInput {
+    static constexpr uint16_t A = 0x0001;
+    static constexpr uint16_t B = 0x0002;
+    static constexpr uint16_t SELECT = 0x0004;
+    static constexpr uint16_t START = 0x0008;
+    static constexpr uint16_t RIGHT = 0x0010;
+    static constexpr uint16_t LEFT = 0x0020;
+    static constexpr uint16_t UP = 0x0040;
+    static constexpr uint16_t DOWN = 0x0080;
+    static constexpr uint16_t DIRECTIONS = RIGHT | LEFT | UP | DOWN;
+
+    uint16_t pressed = 0;
+    uint16_t held = 0;          // Only directions, which auto-repeat
+
+    [[nodiscard]] bool any() const {
+        return pressed;
+    }
+
+    [[nodiscard]] bool has(uint16_t key) const {
+        return pressed & key;
+    }
+};
+
+#if POMI_HOST
+
+// Simulated tick counter with the same rate and 32-bit wrap as bn::timer
+class TickClock {
+public:
+    [[nodiscard]] unsigned elapsed_ticks() const {
+        return _ticks;
+    }
+
+    void advance(unsigned ticks) {
+        _ticks += ticks;
+    }
+
+private:
+    unsigned _ticks = 0;
+};
+
+constexpr unsigned TICKS_PER_SECOND = 262144;
+
+#else
+
+#if POMI_INPUT_REPLAY
+
+// Replayed tick counter: every clock reads the ticks of the current trace
+// frame, advanced by InputTrace once per frame
+class TickClock {
+public:
+    [[nodiscard]] unsigned elapsed_ticks() const {
+        return _replayTicks;
+    }
+
+    static void advanceReplay(unsigned ticks) {
+        _replayTicks += ticks;
+    }
+
+private:
+    static inline unsigned _replayTicks = 0;
+};
+
+#elif POMI_TIME_WARP
+
+// Time-warped tick counter: bn::timer ticks multiplied by POMI_TIME_WARP,
+// with the same 32-bit wrap, reached every few minutes at x60
+class TickClock {
+public:
+    [[nodiscard]] unsigned elapsed_ticks() const {
+        _ticks += static_cast<unsigned>(_timer.elapsed_ticks_with_restart()) * POMI_TIME_WARP;
+        return _ticks;
+    }
+
+private:
+    mutable bn::timer _timer;
+    mutable unsigned _ticks = 0;
+};
+
+#else
+
+using TickClock = bn::timer;
+
+#endif
+
+constexpr unsigned TICKS_PER_SECOND = bn::timers::ticks_per_second();
+
+// Keys pressed and directions held this frame, a single check when none is
+inline KeyInput readKeys() {
+    KeyInput keys;
+
+    if (!bn::keypad::any_held()) {
+        return keys;
+    }
+
+    keys.held = static_cast<uint16_t>((bn::keypad::right_held() ? KeyInput::RIGHT : 0) |
+                                      (bn::keypad::left_held() ? KeyInput::LEFT : 0) |
+                                      (bn::keypad::up_held() ? KeyInput::UP : 0) |
+                                      (bn::keypad::down_held() ? KeyInput::DOWN : 0));
+
+    keys.pressed = static_cast<uint16_t>((bn::keypad::a_pressed() ? KeyInput::A : 0) |
+                                         (bn::keypad::b_pressed() ? KeyInput::B : 0) |
+                                         (bn::keypad::select_pressed() ? KeyInput::SELECT : 0) |
+                                         (bn::keypad::start_pressed() ? KeyInput::START : 0) |
+                                         (bn::keypad::right_pressed() ? KeyInput::RIGHT : 0) |
+                                         (bn::keypad::left_pressed() ? KeyInput::LEFT : 0) |
+                                         (bn::keypad::up_pressed() ? KeyInput::UP : 0) |
+                                         (bn::keypad::down_pressed() ? KeyInput::DOWN : 0));
+    return keys;
+}
+
+#endif
+
+#endif
@@ -0,0 +1,120 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Screens and render functions shared by the main ROM and the benchmark ROM.
+ */
+#ifndef POMI_POMODORO_H
+#define POMI_POMODORO_H
+
+#include "bn_color.h"
+#include "bn_string.h"
+#include "bn_string_view.h"
+#include "bn_vector.h"
+#include "bn_sprite_ptr.h"
+#include "bn_sprite_text_generator.h"
+
+#include "pomodoro_core.h"
+#include "bg_text.h"
+#include "change_key.h"
+#include "sprite_pool.h"
+#include "text_label.h"
+#include "countdown_display.h"
+#include "progress_bar.h"
+#include "state_theme.h"
+#include "time_format.h"
+
+// Screen dimensions
+constexpr int SCREEN_WIDTH = 240;
+constexpr int SCREEN_HEIGHT = 160;
+constexpr int SCREEN_CENTER_X = SCREEN_WIDTH / 2;
+constexpr int SCREEN_CENTER_Y = SCREEN_HEIGHT / 2;
+
+// Y coordinate of a panel's header text
+constexpr int panelHeaderY(int y, int height) {
+    return y - height / 2 - 8;
+}
+
+// Retained UI elements of the timer screen. Static text lives on the BG
+// text layer, sprites are only used for the state label and the countdown.
+// The label falls back to BG text when the sprite budget is short.
+struct PomodoroScreen {
+    PomodoroScreen(const bn::sprite_text_generator& text_generator, const StateTheme& theme, SpritePool& pool) :
+        stateLabel(pool, 0, -40, bn::string_view(), SpritePriority::HINT),
+        countdown(text_generator, pool, theme.spritePalette(), 0, 0) {
+        stateLabel.setPalette(theme.spritePalette());
+    }
+    
+    static constexpr int TITLE_ROW = BgText::rowAt(-70);
+    static constexpr int STATUS_HEADER_ROW = BgText::rowAt(panelHeaderY(-20, 50));
+    static constexpr int CYCLES_ROW = BgText::rowAt(20);
+    static constexpr int LABEL_END_COLUMN = BG_TEXT_COLUMNS / 2;
+    static constexpr int VALUE_COLUMN = LABEL_END_COLUMN + 1;
+    static constexpr int PROGRESS_ROW = BgText::rowAt(35);
+    static constexpr int ALERT_ROW = PROGRESS_ROW + 2;
+    static constexpr int COMMANDS_HEADER_ROW = BgText::rowAt(panelHeaderY(80, 30));
+    static constexpr int COMMAND_LINE_ROW = BgText::rowAt(70);
+    static constexpr int GROUP_COLUMN = BG_TEXT_COLUMNS - 7;
+    
+    TextLabel stateLabel;
+    CountdownDisplay countdown;
+    ProgressBar progress = ProgressBar(5, PROGRESS_ROW, 20);
+    ChangeKey cyclesKey;
+    ChangeKey commandLineKey;
+    ChangeKey alertKey;
+    ChangeKey groupKey;
+    bool shown = false;
+
+    void show(BgText& bgText);
+    void refresh(bn::sprite_text_generator& text_generator);
+    void invalidate();
+    void release();
+};
+
+// Retained UI elements of the configuration menu, drawn on the BG text layer
+struct ConfigScreen {
+    static constexpr int TITLE_ROW = BgText::rowAt(-70);
+    static constexpr int PARAMS_HEADER_ROW = BgText::rowAt(panelHeaderY(0, 100));
+    static constexpr int ITEM_ROWS[4] = { 5, 8, 11, 14 };
+    static constexpr int CURSOR_COLUMN = BgText::columnAt(-75);
+    static constexpr int LABEL_END_COLUMN = BG_TEXT_COLUMNS / 2;
+    static constexpr int VALUE_COLUMN = LABEL_END_COLUMN + 1;
+    static constexpr int VALUE_CELLS = 3;   // "99m"
+    static constexpr int FOOTER_ROW = BgText::rowAt(60);
+    static constexpr int STATS_HINT_ROW = FOOTER_ROW + 1;
+    
+    ChangeKey itemKeys[4];
+    ChangeKey cursorKey;
+    int cursorRow = ITEM_ROWS[0];
+    bool shown = false;
+
+    void show(BgText& bgText);
+    void release();
+};
+
+// Statistics screen: drawn once into the BG text layer when it opens
+struct StatsScreen {
+    static constexpr int TITLE_ROW = BgText::rowAt(-70);
+    static constexpr int TODAY_ROW = 3;
+    static constexpr int STREAK_ROW = 4;
+    static constexpr int INTERRUPTIONS_ROW = 5;
+    static constexpr int CHART_HEADER_ROW = 7;
+    static constexpr int CHART_TOP_ROW = 8;
+    static constexpr int CHART_ROWS = 6;
+    static constexpr int CHART_LABEL_ROW = CHART_TOP_ROW + CHART_ROWS;
+    static constexpr int CHART_SCALE_ROW = CHART_LABEL_ROW + 1;
+    static constexpr int FOOTER_ROW = BgText::rowAt(60);
+    
+    bool shown = false;
+    bool filled = false;        // Statistics written since the chrome was loaded
+
+    void show(BgText& bgText);
+    void release();
+};
+
+// Function declarations
+bn::color stateColor(const PomodoroContext& ctx);
+void renderPomodoro(PomodoroContext& ctx, BgText& bgText, PomodoroScreen& screen);
+void renderProgress(PomodoroContext& ctx, PomodoroScreen& screen);
+void renderConfig(PomodoroContext& ctx, BgText& bgText, ConfigScreen& screen);
+void renderStats(PomodoroContext& ctx, BgText& bgText, StatsScreen& screen);
+
+#endif
@@ -0,0 +1,35 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * State transitions of the timer core
+ */
+#include "pomodoro_core.h"
+
+// Change the timer state
+void changeState(PomodoroContext& ctx, PomodoroState newState) {
+    // Store previous state for transition effects
+    PomodoroState oldState = ctx.state;
+    
+    // Update state
+    ctx.state = newState;
+    
+    // Reset timer activity when changing states
+    if (oldState != newState && newState != PomodoroState::CONFIG) {
+        ctx.timerActive = false;
+    }
+    
+    // A new interval starts on a whole second
+    ctx.timebase.reset(ctx.timer.elapsed_ticks());
+    
+    // Set the new timer based on the state (IDLE and CONFIG use the work time)
+    ctx.secondsRemaining = stateDuration(ctx);
+    
+    // Play transition sound
+    if (oldState != newState) {
+        playSound(stateDescriptor(newState).transitionSound);
+    }
+}
+
+// Full duration of the current state's interval
+int stateDuration(const PomodoroContext& ctx) {
+    return ctx.config.*stateDescriptor(ctx.state).duration;
+}
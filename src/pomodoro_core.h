@@ -0,0 +1,173 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Pomodoro state machine: context, state descriptors and the timer core.
+ *
+ * Nothing here touches the display. Ticks and keys come through the platform
+ * interfaces, so the core also builds natively for host simulation.
+ */
+#ifndef POMI_POMODORO_CORE_H
+#define POMI_POMODORO_CORE_H
+
+#include <cstdint>
+
+#include "bn_color.h"
+#include "bn_string_view.h"
+#include "bn_optional.h"
+
+#include "platform.h"
+#include "input_events.h"
+#include "code_placement.h"
+#include "seconds_counter.h"
+#include "timebase.h"
+#include "clock_time.h"
+#include "session_stats.h"
+#include "deadline_scheduler.h"
+
+static_assert(!POMI_HOST || !POMI_HW_SECONDS, "The hardware seconds counter is not available on the host");
+
+// Set by the benchmark ROM build, which provides its own main()
+#ifndef POMI_BENCHMARK
+    #define POMI_BENCHMARK 0
+#endif
+
+// Pomodoro States
+enum class PomodoroState {
+    IDLE,
+    WORK,
+    SHORT_BREAK,
+    LONG_BREAK,
+    CONFIG,
+    STATS
+};
+
+constexpr int POMODORO_STATES = 6;
+
+// Pomodoro Configuration
+struct PomodoroConfig {
+    int workTime = 25 * 60;         // 25 minutes
+    int shortBreakTime = 5 * 60;    // 5 minutes
+    int longBreakTime = 15 * 60;    // 15 minutes
+    int sessionsPerSet = 4;         // 4 sessions before a long break
+    bn::color workColor = bn::color(31, 0, 0);     // Red
+    bn::color shortColor = bn::color(0, 31, 0);    // Green
+    bn::color longColor = bn::color(0, 0, 31);     // Blue
+};
+
+// Sound effects played by the state machine
+enum class SoundId {
+    NONE,
+    WORK_START,
+    BREAK_START,
+    STANDBY,
+    TIMER_END,
+    REMINDER
+};
+
+// Everything that varies per state, looked up with a single indexed load
+struct StateDescriptor {
+    int PomodoroConfig::* duration;        // Interval length in the config
+    bn::color PomodoroConfig::* accent;    // Accent color in the config, or nullptr
+    bn::color defaultAccent;               // Accent color when there is no config entry
+    bn::string_view label;
+    bn::string_view pausedLabel;
+    SoundId transitionSound;               // Played when entering the state
+};
+
+// Indexed by PomodoroState
+constexpr StateDescriptor STATE_DESCRIPTORS[] = {
+    // IDLE
+    { &PomodoroConfig::workTime, nullptr, bn::color(31, 31, 31), "STANDBY", "STANDBY", SoundId::STANDBY },
+    // WORK
+    { &PomodoroConfig::workTime, &PomodoroConfig::workColor, bn::color(),
+      "WORK", "WORK - PAUSED", SoundId::WORK_START },
+    // SHORT_BREAK
+    { &PomodoroConfig::shortBreakTime, &PomodoroConfig::shortColor, bn::color(),
+      "SHORT REST", "SHORT REST - PAUSED", SoundId::BREAK_START },
+    // LONG_BREAK
+    { &PomodoroConfig::longBreakTime, &PomodoroConfig::longColor, bn::color(),
+      "LONG REST", "LONG REST - PAUSED", SoundId::BREAK_START },
+    // CONFIG (keeps the work time as the default interval)
+    { &PomodoroConfig::workTime, nullptr, bn::color(0, 31, 31), "CONFIG", "CONFIG", SoundId::NONE },
+    // STATS (opened from the config menu)
+    { &PomodoroConfig::workTime, nullptr, bn::color(31, 31, 0), "STATS", "STATS", SoundId::NONE }
+};
+
+static_assert(sizeof(STATE_DESCRIPTORS) / sizeof(STATE_DESCRIPTORS[0]) == POMODORO_STATES,
+              "Missing state descriptors");
+
+constexpr const StateDescriptor& stateDescriptor(PomodoroState state) {
+    return STATE_DESCRIPTORS[static_cast<int>(state)];
+}
+
+// Part played in a link cable group, see link_sync.h
+enum class GroupRole {
+    SOLO,
+    LEADER,
+    FOLLOWER
+};
+
+// A finished WORK, SHORT_BREAK or LONG_BREAK interval
+struct SessionRecord {
+    PomodoroState state = PomodoroState::WORK;
+    uint32_t startTime = 0;     // Session clock seconds when the timer was first started
+    int plannedSeconds = 0;
+    int actualSeconds = 0;      // From start to end, pauses included
+    int focusSeconds = 0;       // Seconds actually timed
+    int pauses = 0;
+    bool paused = false;        // Paused at least once
+    bool reset = false;         // Ended by B or by leaving for the menu instead of reaching zero
+};
+
+// Pomodoro Context
+struct PomodoroContext {
+    PomodoroConfig config;
+    PomodoroState state = PomodoroState::IDLE;
+    int secondsRemaining = 0;
+    int completedSessions = 0;
+    int completedSets = 0;
+    bool timerActive = false;
+    int configSelection = 0;
+    TickClock timer;
+    Timebase<TICKS_PER_SECOND> timebase;  // Carries sub-second remainder
+#if POMI_HW_SECONDS
+    SecondsCounter seconds;   // Hardware seconds timebase
+#endif
+    
+    // Session clock: seconds counted while powered on, resumed from the history at boot
+    uint32_t clockSeconds = 0;
+    Timebase<TICKS_PER_SECOND> clock;
+    bool wallClock = false;   // clockSeconds follows the cartridge RTC
+    
+    // Interval being timed, recorded in the session history when it ends
+    bool sessionStarted = false;
+    int sessionPauses = 0;
+    uint32_t sessionStart = 0;
+    bn::optional<SessionRecord> finishedSession;  // Consumed by SessionHistory::update
+    
+    // Running aggregates for the statistics screen, saved with the config
+    SessionStats stats;
+    
+    // Reminders and idle sleep, due on the session clock
+    DeadlineScheduler deadlines;
+    int reminderAlert = -1;   // Index of the reminder shown on the timer screen, or -1
+    
+    // Link cable group, followers lock their timer to the leader's
+    GroupRole groupRole = GroupRole::SOLO;
+    int groupPlayers = 1;
+    bool groupConfigMatch = true;   // The leader's config hash matches ours
+};
+
+// Core functions. handleInput only dispatches keys, rendering is up to the caller
+void changeState(PomodoroContext& ctx, PomodoroState newState);
+int stateDuration(const PomodoroContext& ctx);
+POMI_CORE_CODE bool handleInput(PomodoroContext& ctx, InputEvents& events);
+POMI_CORE_CODE bool updateTimer(PomodoroContext& ctx);
+POMI_CORE_CODE void resumeTimer(PomodoroContext& ctx, uint32_t deadline);
+POMI_CORE_CODE void setTimerActive(PomodoroContext& ctx, bool active);
+POMI_CORE_CODE void followState(PomodoroContext& ctx, PomodoroState state);
+
+// Provided by the platform: PSG chimes on the GBA, counters on the host
+void playSound(int frequency, int duration);
+void playSound(SoundId sound);
+
+#endif
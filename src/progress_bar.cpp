@@ -0,0 +1,75 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Window-driven progress bar implementation
+ */
+#include "progress_bar.h"
+
+#include "bg_text.h"
+
+namespace {
+    // Screen-centered pixel coordinate of a map cell edge
+    constexpr int cellX(int column) {
+        return column * 8 - BG_TEXT_COLUMNS * 8 / 2;
+    }
+    
+    constexpr int cellY(int row) {
+        return row * 8 - BG_TEXT_ROWS * 8 / 2;
+    }
+}
+
+ProgressBar::ProgressBar(int column, int row, int length) :
+    _window(bn::rect_window::internal()),
+    _column(column),
+    _row(row),
+    _length(length) {
+    _window.set_boundaries(0, 0, 0, 0);
+}
+
+void ProgressBar::show(BgText& bgText) {
+    bgText.write(_column - 1, _row, "[");
+    bgText.fill(_column, _row, _length, '\x7F', BgTextColor::ACCENT);
+    bgText.write(_column + _length, _row, "]");
+    
+    // Keep showing everything but the text layer inside the window
+    _window.set_show_bg(bgText.bg(), false);
+    _visible = true;
+    _fillWidth = -1;
+}
+
+void ProgressBar::hide() {
+    if (_visible) {
+        _visible = false;
+        _window.set_boundaries(0, 0, 0, 0);
+    }
+}
+
+void ProgressBar::setProgress(int elapsedSeconds, int fraction, int totalSeconds) {
+    if (!_visible) {
+        return;
+    }
+    
+    int width = _length * 8;
+    int fillWidth = width;
+    
+    if (totalSeconds > 0 && elapsedSeconds < totalSeconds) {
+        // Fixed point position keeps the sub-second fraction of the elapsed time
+        fillWidth = (elapsedSeconds * width + ((fraction * width) >> 12)) / totalSeconds;
+        
+        if (fillWidth < 0) {
+            fillWidth = 0;
+        }
+    }
+    
+    if (fillWidth != _fillWidth) {
+        _fillWidth = fillWidth;
+        updateWindow();
+    }
+}
+
+void ProgressBar::updateWindow() {
+    // The window covers the unfilled part of the bar
+    int top = cellY(_row);
+    int left = cellX(_column) + _fillWidth;
+    int right = cellX(_column + _length);
+    _window.set_boundaries(top, left, top + 8, right);
+}
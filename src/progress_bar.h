@@ -0,0 +1,46 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Window-driven progress bar.
+ *
+ * The bar is a row of accent colored block glyphs on the BG text layer that
+ * is written once. A rect window hides the text layer over the unfilled part,
+ * so a progress update is just a window edge move.
+ */
+#ifndef POMI_PROGRESS_BAR_H
+#define POMI_PROGRESS_BAR_H
+
+#include "bn_rect_window.h"
+
+class BgText;
+
+class ProgressBar {
+public:
+    // Bar covering length map cells starting at the given cell
+    ProgressBar(int column, int row, int length);
+
+    // Write the bar glyphs and start clipping them
+    void show(BgText& bgText);
+
+    void hide();
+
+    // Set the filled part from elapsed whole seconds plus a sub-second fraction
+    // in 1/4096 units, so the edge keeps moving between second ticks
+    void setProgress(int elapsedSeconds, int fraction, int totalSeconds);
+
+    // Filled width in pixels
+    [[nodiscard]] int fillWidth() const {
+        return _fillWidth;
+    }
+
+private:
+    bn::rect_window _window;
+    int _column;
+    int _row;
+    int _length;
+    int _fillWidth = -1;
+    bool _visible = false;
+
+    void updateWindow();
+};
+
+#endif
@@ -0,0 +1,94 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * PSG sound effects implementation
+ */
+#include "psg_audio.h"
+
+namespace {
+    constexpr uintptr_t SOUND1CNT_L = 0x04000060;
+    constexpr uintptr_t SOUND1CNT_H = 0x04000062;
+    constexpr uintptr_t SOUND1CNT_X = 0x04000064;
+    constexpr uintptr_t SOUND2CNT_L = 0x04000068;
+    constexpr uintptr_t SOUND2CNT_H = 0x0400006C;
+    constexpr uintptr_t SOUND4CNT_L = 0x04000078;
+    constexpr uintptr_t SOUND4CNT_H = 0x0400007C;
+    constexpr uintptr_t SOUNDCNT_L = 0x04000080;
+    constexpr uintptr_t SOUNDCNT_H = 0x04000082;
+    constexpr uintptr_t SOUNDCNT_X = 0x04000084;
+
+    constexpr uint16_t SOUND_RESTART = 0x8000;
+    constexpr uint16_t SOUND_MASTER_ENABLE = 0x0080;
+
+    // Master volume 7 and channels 1, 2 and 4 on both speakers
+    constexpr uint16_t PSG_CHANNELS = 0x1 | 0x2 | 0x8;
+    constexpr uint16_t PSG_MIX = 0x77 | (PSG_CHANNELS << 8) | (PSG_CHANNELS << 12);
+
+    // SOUNDCNT_H bits 0-1: PSG volume relative to direct sound (2 is 100%)
+    constexpr uint16_t PSG_VOLUME_MASK = 0x0003;
+    constexpr uint16_t PSG_VOLUME_FULL = 0x0002;
+
+    volatile uint16_t& reg(uintptr_t address) {
+        return *reinterpret_cast<volatile uint16_t*>(address);
+    }
+
+    struct ChannelRegisters {
+        uintptr_t control;
+        uintptr_t frequency;
+    };
+
+    // Indexed by PsgChannel
+    constexpr ChannelRegisters CHANNEL_REGISTERS[] = {
+        { SOUND1CNT_H, SOUND1CNT_X },
+        { SOUND2CNT_L, SOUND2CNT_H },
+        { SOUND4CNT_L, SOUND4CNT_H }
+    };
+
+    // Sequence in progress
+    const PsgNote* nextNote = nullptr;
+    int notesLeft = 0;
+    int waitFrames = 0;
+}
+
+void initAudio() {
+    reg(SOUNDCNT_X) = SOUND_MASTER_ENABLE;
+    reg(SOUNDCNT_L) = PSG_MIX;
+
+    // Square 1 notes are plain tones, whatever sweep the BIOS or backend left
+    reg(SOUND1CNT_L) = 0;
+
+    // Keep the direct sound settings of the audio backend
+    reg(SOUNDCNT_H) = static_cast<uint16_t>((reg(SOUNDCNT_H) & ~PSG_VOLUME_MASK) | PSG_VOLUME_FULL);
+}
+
+void playNote(const PsgNote& note) {
+    const ChannelRegisters& registers = CHANNEL_REGISTERS[static_cast<int>(note.channel)];
+    reg(registers.control) = note.control;
+    reg(registers.frequency) = note.frequency | SOUND_RESTART;
+}
+
+void playNotes(const PsgNote* notes, int count) {
+    nextNote = notes;
+    notesLeft = count;
+    waitFrames = count ? notes->delayFrames : 0;
+}
+
+void updateAudio() {
+    if (!notesLeft) {
+        return;
+    }
+
+    if (waitFrames > 0) {
+        --waitFrames;
+        return;
+    }
+
+    // Notes without a delay start on the same frame
+    do {
+        playNote(*nextNote++);
+        --notesLeft;
+    } while (notesLeft && !nextNote->delayFrames);
+
+    if (notesLeft) {
+        waitFrames = nextNote->delayFrames - 1;
+    }
+}
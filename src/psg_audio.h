@@ -0,0 +1,97 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Sound effects on the DMG PSG channels.
+ *
+ * Notes are register values computed at compile time: the square channel
+ * rate for a frequency, and a volume envelope that fades out over the note
+ * duration (cut off by the length counter for notes under a quarter second).
+ * The hardware ends every note by itself, so a single sound costs no CPU
+ * after it is triggered. Multi-note chimes are started by a tiny sequencer that
+ * only compares a frame countdown while a chime is playing.
+ *
+ * The PSG channels do not depend on the audio backend, so the ROM can be built
+ * without maxmod (make POMI_AUDIO=null) and keep its sound effects.
+ */
+#ifndef POMI_PSG_AUDIO_H
+#define POMI_PSG_AUDIO_H
+
+#include <cstdint>
+
+// Set by the Makefile when maxmod is dropped
+#ifndef POMI_AUDIO_NULL
+    #define POMI_AUDIO_NULL 0
+#endif
+
+constexpr const char* AUDIO_BACKEND_NAME = POMI_AUDIO_NULL ? "null" : "maxmod";
+
+enum class PsgChannel : uint8_t {
+    SQUARE1,
+    SQUARE2,
+    NOISE
+};
+
+// One note of a sound effect
+struct PsgNote {
+    PsgChannel channel;
+    uint8_t delayFrames;    // Frames to wait after the previous note
+    uint16_t control;       // Length, duty and envelope (SOUNDxCNT_H, or SOUND4CNT_L)
+    uint16_t frequency;     // Rate or noise clock and length enable (SOUNDxCNT_X, or SOUND4CNT_H)
+};
+
+namespace psg {
+    constexpr uint16_t LENGTH_ENABLE = 0x4000;
+    constexpr int MAX_VOLUME = 15;
+    constexpr int MAX_ENVELOPE_STEP = 7;
+
+    // Envelope step time for a full volume note to fade out over about the
+    // given frames: each of the 15 volume steps lasts step / 64 seconds
+    constexpr int envelopeStep(int durationFrames) {
+        int step = (durationFrames * 64 + 30 * MAX_VOLUME) / (60 * MAX_VOLUME);
+        return step < 1 ? 1 : step > MAX_ENVELOPE_STEP ? MAX_ENVELOPE_STEP : step;
+    }
+
+    // The length counter cuts notes off after (64 - length) / 256 seconds
+    constexpr bool timed(int durationFrames) {
+        return durationFrames * 256 < 64 * 60;
+    }
+
+    constexpr int length(int durationFrames) {
+        return timed(durationFrames) ? 64 - (durationFrames * 256 + 30) / 60 : 0;
+    }
+
+    constexpr uint16_t control(int durationFrames, int duty) {
+        return static_cast<uint16_t>((MAX_VOLUME << 12) | (envelopeStep(durationFrames) << 8) | (duty << 6) |
+                                     length(durationFrames));
+    }
+}
+
+// Square channel note: frequency = 131072 / (2048 - rate) Hz. Duty is 0 (12.5%) to 3 (75%)
+constexpr PsgNote squareNote(PsgChannel channel, int frequencyHz, int durationFrames, int delayFrames = 0,
+                             int duty = 2) {
+    return { channel, static_cast<uint8_t>(delayFrames), psg::control(durationFrames, duty),
+             static_cast<uint16_t>((2048 - 131072 / frequencyHz) |
+                                   (psg::timed(durationFrames) ? psg::LENGTH_ENABLE : 0)) };
+}
+
+// Noise channel note: clock = 524288 / ratio / 2^(shift + 1) Hz (ratio 0 counts as 0.5)
+constexpr PsgNote noiseNote(int shift, int ratio, int durationFrames, int delayFrames = 0) {
+    return { PsgChannel::NOISE, static_cast<uint8_t>(delayFrames), psg::control(durationFrames, 0),
+             static_cast<uint16_t>((shift << 4) | ratio | (psg::timed(durationFrames) ? psg::LENGTH_ENABLE : 0)) };
+}
+
+// Enable the PSG channels at full volume on both speakers
+void initAudio();
+
+// Trigger a note now
+void playNote(const PsgNote& note);
+
+// Play a sequence of notes, replacing the one in progress. The first notes
+// start on this frame's updateAudio() call. The notes must outlive the
+// sequence (use static constexpr arrays)
+void playNotes(const PsgNote* notes, int count);
+
+// Trigger the next notes of the sequence when their delay has elapsed.
+// Call once per frame
+void updateAudio();
+
+#endif
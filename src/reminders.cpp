@@ -0,0 +1,32 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Reminders implementation
+ */
+#include "reminders.h"
+
+void armReminders(PomodoroContext& ctx) {
+    for (const ReminderDescriptor& reminder : REMINDERS) {
+        if (reminder.intervalSeconds) {
+            ctx.deadlines.schedule(reminder.id, ctx.clockSeconds + reminder.intervalSeconds);
+        }
+    }
+}
+
+void fireReminder(PomodoroContext& ctx, DeadlineId id) {
+    if (id == DeadlineId::ALERT_CLEAR) {
+        ctx.reminderAlert = -1;
+        return;
+    }
+
+    for (int index = 0; index < REMINDER_COUNT; ++index) {
+        const ReminderDescriptor& reminder = REMINDERS[index];
+
+        if (reminder.id == id) {
+            ctx.reminderAlert = index;
+            ctx.deadlines.schedule(id, ctx.clockSeconds + reminder.intervalSeconds);
+            ctx.deadlines.schedule(DeadlineId::ALERT_CLEAR, ctx.clockSeconds + REMINDER_ALERT_SECONDS);
+            playSound(SoundId::REMINDER);
+            return;
+        }
+    }
+}
@@ -0,0 +1,46 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Recurring reminders that run alongside the pomodoro timer.
+ *
+ * Each reminder is an event of the deadline scheduler: when it fires, its alert
+ * is shown on the timer screen for a few seconds and it is rescheduled one
+ * interval later.
+ */
+#ifndef POMI_REMINDERS_H
+#define POMI_REMINDERS_H
+
+#include "pomodoro_core.h"
+
+// Reminder intervals in minutes (0 disables the reminder)
+#ifndef POMI_STRETCH_MINUTES
+    #define POMI_STRETCH_MINUTES 50
+#endif
+
+#ifndef POMI_HYDRATE_MINUTES
+    #define POMI_HYDRATE_MINUTES 30
+#endif
+
+// Seconds a reminder alert stays on screen
+constexpr uint32_t REMINDER_ALERT_SECONDS = 10;
+
+struct ReminderDescriptor {
+    DeadlineId id;
+    uint32_t intervalSeconds;
+    bn::string_view label;
+};
+
+constexpr ReminderDescriptor REMINDERS[] = {
+    { DeadlineId::STRETCH, POMI_STRETCH_MINUTES * 60, "STRETCH!" },
+    { DeadlineId::HYDRATE, POMI_HYDRATE_MINUTES * 60, "HYDRATE!" }
+};
+
+constexpr int REMINDER_COUNT = sizeof(REMINDERS) / sizeof(REMINDERS[0]);
+
+// Schedule every enabled reminder one interval from now. Called at boot and
+// after waking up, so reminders missed while asleep do not fire all at once
+void armReminders(PomodoroContext& ctx);
+
+// Handle a due reminder or alert event
+void fireReminder(PomodoroContext& ctx, DeadlineId id);
+
+#endif
@@ -0,0 +1,67 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Render stage scheduling.
+ *
+ * The logic stage (input, timer, link, history, saves and deadlines) runs
+ * every frame and counts time on the tick Timebase, so it doesn't depend on
+ * how often the screen is redrawn. The render stage (screen transitions,
+ * screen updates, theme fades and the progress bar) only runs on frames
+ * where something is dirty, and at most at POMI_RENDER_HZ:
+ *
+ *   60  every frame (default)
+ *   30  every other frame
+ *   15  every fourth frame
+ *    1  once a second, an "eco" profile for battery powered units
+ *
+ * Input redraws are urgent and skip the rate limit, so input latency stays
+ * at one frame with any profile. Frame-skip policies belong here, not in the
+ * render functions.
+ */
+#ifndef POMI_RENDER_SCHEDULE_H
+#define POMI_RENDER_SCHEDULE_H
+
+#ifndef POMI_RENDER_HZ
+    #define POMI_RENDER_HZ 60
+#endif
+
+static_assert(POMI_RENDER_HZ > 0 && POMI_RENDER_HZ <= 60 && 60 % POMI_RENDER_HZ == 0,
+              "The render rate must divide 60 Hz");
+
+// Frames between two rate limited renders
+constexpr int RENDER_FRAME_INTERVAL = 60 / POMI_RENDER_HZ;
+
+// Palette fades step once per render, too slow to be worth it below 15 Hz
+constexpr bool RENDER_FADES = POMI_RENDER_HZ >= 15;
+
+class RenderSchedule {
+public:
+    // Something on screen is out of date. Urgent redraws run on the next
+    // render stage whatever the rate limit
+    void invalidate(bool urgent = false) {
+        _dirty = true;
+        _urgent = _urgent || urgent;
+    }
+
+    // Returns true if the render stage runs this frame, call once per frame
+    bool due() {
+        if (_framesSinceRender < RENDER_FRAME_INTERVAL) {
+            ++_framesSinceRender;
+        }
+
+        if (!_urgent && (!_dirty || _framesSinceRender < RENDER_FRAME_INTERVAL)) {
+            return false;
+        }
+
+        _dirty = false;
+        _urgent = false;
+        _framesSinceRender = 0;
+        return true;
+    }
+
+private:
+    int _framesSinceRender = RENDER_FRAME_INTERVAL;
+    bool _dirty = true;
+    bool _urgent = false;
+};
+
+#endif
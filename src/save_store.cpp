@@ -0,0 +1,222 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * SRAM save store implementation
+ */
+#include "save_store.h"
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include "bn_sram.h"
+
+#include "checksum.h"
+
+namespace {
+    constexpr uint32_t SAVE_MAGIC = 0x494D4F50;  // "POMI"
+    constexpr uint16_t SAVE_VERSION = 1;
+
+    // A slot as stored in SRAM, padded to its reserved size
+    struct RawSlot {
+        uint8_t bytes[SAVE_SLOT_MAX_SIZE];
+    };
+
+    // Both slots as stored in SRAM, read at once
+    struct RawArea {
+        RawSlot slots[SAVE_SLOTS];
+    };
+
+    struct SaveArea {
+        SaveSlot slots[SAVE_SLOTS];
+    };
+    
+    constexpr int slotOffset(int slot) {
+        return SAVE_SLOTS_OFFSET + slot * SAVE_SLOT_MAX_SIZE;
+    }
+
+    // version, sequence and payload are contiguous
+    uint16_t slotChecksum(const SaveSlot& slot) {
+        return fletcher16(&slot.version, int(offsetof(SaveSlot, checksum) - offsetof(SaveSlot, version)));
+    }
+
+    bool validMinutes(int seconds) {
+        return seconds >= 60 && seconds <= MAX_CONFIG_MINUTES * 60 && splitClock(seconds).seconds == 0;
+    }
+
+    bool validPayload(const SavePayload& payload) {
+        return validMinutes(payload.workTime) && validMinutes(payload.shortBreakTime) &&
+               validMinutes(payload.longBreakTime) &&
+               payload.sessionsPerSet >= 1 && payload.sessionsPerSet <= MAX_CONFIG_SESSIONS;
+    }
+
+    // Sequence numbers wrap, a slot is newer if it is less than half the range ahead
+    bool newerSequence(uint16_t sequence, uint16_t other) {
+        return static_cast<int16_t>(sequence - other) > 0;
+    }
+
+    SavePayload makePayload(const PomodoroContext& ctx) {
+        SavePayload payload = {};
+        payload.workTime = static_cast<uint16_t>(ctx.config.workTime);
+        payload.shortBreakTime = static_cast<uint16_t>(ctx.config.shortBreakTime);
+        payload.longBreakTime = static_cast<uint16_t>(ctx.config.longBreakTime);
+        payload.sessionsPerSet = static_cast<uint16_t>(ctx.config.sessionsPerSet);
+        payload.completedSessions = static_cast<uint32_t>(ctx.completedSessions);
+        payload.completedSets = static_cast<uint32_t>(ctx.completedSets);
+        payload.stats = ctx.stats;
+
+        payload.state = static_cast<uint8_t>(ctx.state);
+        payload.flags = static_cast<uint8_t>(SAVE_CHECKPOINT | (ctx.timerActive ? SAVE_TIMER_ACTIVE : 0) |
+                                             (ctx.sessionStarted ? SAVE_SESSION_STARTED : 0) |
+                                             (ctx.wallClock ? SAVE_WALL_CLOCK : 0));
+        payload.sessionPauses = static_cast<uint16_t>(ctx.sessionPauses);
+        payload.secondsRemaining = static_cast<uint16_t>(ctx.secondsRemaining);
+        payload.clockSeconds = ctx.clockSeconds;
+        payload.sessionStart = ctx.sessionStart;
+        return payload;
+    }
+
+    static_assert(std::has_unique_object_representations_v<SavePayload>, "Save payload has padding");
+
+    // The session clock goes forward every second, so it is written along with
+    // the other fields rather than on its own. A running interval is still
+    // checkpointed every SAVE_CHECKPOINT_SECONDS, as its countdown changes
+    bool samePayload(const SavePayload& a, const SavePayload& b) {
+        SavePayload other = b;
+        other.clockSeconds = a.clockSeconds;
+        return std::memcmp(&a, &other, sizeof(SavePayload)) == 0;
+    }
+
+    // Copy a slot out of its reserved area. Returns false if it is not valid
+    bool decodeSlot(const RawSlot& raw, SaveSlot& slot) {
+        std::memcpy(static_cast<void*>(&slot), raw.bytes, sizeof(SaveSlot));
+        return slot.magic == SAVE_MAGIC && slot.version == SAVE_VERSION && slot.checksum == slotChecksum(slot) &&
+               validPayload(slot.payload);
+    }
+}
+
+bool SaveStore::load(PomodoroContext& ctx) {
+    _lastState = ctx.state;
+
+    _statsKey.changed(static_cast<int>(ctx.stats.workSessions));
+    _activeKey.changed(ctx.timerActive);
+
+    RawArea raw;
+    bn::sram::read_offset(raw, slotOffset(0));
+
+    SaveArea area;
+    int newest = -1;
+
+    for (int index = 0; index < SAVE_SLOTS; ++index) {
+        if (decodeSlot(raw.slots[index], area.slots[index]) &&
+                (newest < 0 || newerSequence(area.slots[index].sequence, area.slots[newest].sequence))) {
+            newest = index;
+        }
+    }
+
+    if (newest < 0) {
+        return false;
+    }
+
+    const SavePayload& payload = area.slots[newest].payload;
+    ctx.config.workTime = payload.workTime;
+    ctx.config.shortBreakTime = payload.shortBreakTime;
+    ctx.config.longBreakTime = payload.longBreakTime;
+    ctx.config.sessionsPerSet = payload.sessionsPerSet;
+    ctx.completedSessions = static_cast<int>(payload.completedSessions);
+    ctx.completedSets = static_cast<int>(payload.completedSets);
+    ctx.stats = payload.stats;
+    _statsKey.changed(static_cast<int>(ctx.stats.workSessions));
+
+    _saved = payload;
+    _sequence = area.slots[newest].sequence;
+    _slot = (newest + 1) % SAVE_SLOTS;
+    _valid = true;
+    return true;
+}
+
+void SaveStore::resume(PomodoroContext& ctx) {
+    const SavePayload& checkpoint = _saved;
+
+    // Menus are not restored, the timer screen starts with a full interval instead
+    if (!_valid || !(checkpoint.flags & SAVE_CHECKPOINT) ||
+            checkpoint.state > static_cast<uint8_t>(PomodoroState::LONG_BREAK)) {
+        return;
+    }
+
+    ctx.state = static_cast<PomodoroState>(checkpoint.state);
+    int duration = stateDuration(ctx);
+    ctx.secondsRemaining = checkpoint.secondsRemaining >= 1 && checkpoint.secondsRemaining <= duration ?
+                           checkpoint.secondsRemaining : duration;
+
+    // Without a wall clock the time spent off is unknown, the session clock
+    // continues from the checkpoint so it never goes backwards
+    bool sameClock = ctx.wallClock == bool(checkpoint.flags & SAVE_WALL_CLOCK);
+
+    if (!ctx.wallClock && checkpoint.clockSeconds > ctx.clockSeconds) {
+        ctx.clockSeconds = checkpoint.clockSeconds;
+        ctx.clock.reset(ctx.timer.elapsed_ticks());
+    }
+
+    // The open interval is kept only if its start is on the same clock
+    ctx.sessionStarted = (checkpoint.flags & SAVE_SESSION_STARTED) && sameClock &&
+                         checkpoint.sessionStart <= ctx.clockSeconds;
+    ctx.sessionPauses = checkpoint.sessionPauses;
+    ctx.sessionStart = checkpoint.sessionStart;
+
+    // A running interval continues from its deadline: one clock read and a
+    // subtraction, crossing the end of the interval if it was missed.
+    // Otherwise it resumes paused at the checkpoint
+    if (ctx.wallClock && sameClock && (checkpoint.flags & SAVE_TIMER_ACTIVE)) {
+        resumeTimer(ctx, checkpoint.clockSeconds + static_cast<uint32_t>(ctx.secondsRemaining));
+    }
+}
+
+void SaveStore::update(const PomodoroContext& ctx, bool input) {
+    // State transitions carry counter changes and leaving the config menu,
+    // interrupted intervals change the statistics without a transition.
+    // Starting, pausing and running intervals are checkpointed too
+    bool statsChanged = _statsKey.changed(static_cast<int>(ctx.stats.workSessions));
+    bool activeChanged = _activeKey.changed(ctx.timerActive);
+    bool checkpointDue = ctx.timerActive && ctx.clockSeconds - _saved.clockSeconds >= SAVE_CHECKPOINT_SECONDS;
+
+    if (ctx.state != _lastState || statsChanged || activeChanged || checkpointDue) {
+        _lastState = ctx.state;
+        flush(ctx);
+        return;
+    }
+
+    if (ctx.state != PomodoroState::CONFIG) {
+        return;
+    }
+
+    if (input) {
+        _pending = true;
+        _idleFrames = 0;
+    } else if (_pending && ++_idleFrames >= SAVE_CONFIG_IDLE_FRAMES) {
+        flush(ctx);
+    }
+}
+
+void SaveStore::flush(const PomodoroContext& ctx) {
+    _pending = false;
+    _idleFrames = 0;
+
+    SavePayload payload = makePayload(ctx);
+
+    if (_valid && samePayload(payload, _saved)) {
+        return;
+    }
+
+    SaveSlot slot = {};
+    slot.magic = SAVE_MAGIC;
+    slot.version = SAVE_VERSION;
+    slot.sequence = ++_sequence;
+    slot.payload = payload;
+    slot.checksum = slotChecksum(slot);
+
+    bn::sram::write_offset(slot, slotOffset(_slot));
+
+    _saved = payload;
+    _slot = (_slot + 1) % SAVE_SLOTS;
+    _valid = true;
+}
@@ -0,0 +1,96 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Persistent config and counters in SRAM.
+ *
+ * The save block is written to two alternating slots, each one versioned,
+ * sequence numbered and checksummed, so a write interrupted by a power cut
+ * leaves the previous slot intact. Writes are coalesced: the block is only
+ * flushed on state transitions, when the timer is started or paused, when the
+ * statistics change, once a minute while the timer runs or after the config
+ * menu has been left alone for a few seconds, and only if its contents
+ * other than the session clock changed. Both slots are read in one SRAM read
+ * at boot.
+ *
+ * Each flush also checkpoints the current interval. With a wall clock the
+ * checkpoint time plus the remaining seconds is the deadline of a running
+ * interval, so it resumes at boot as if the console had never been off.
+ */
+#ifndef POMI_SAVE_STORE_H
+#define POMI_SAVE_STORE_H
+
+#include <cstdint>
+
+#include "pomodoro_core.h"
+#include "change_key.h"
+#include "sram_layout.h"
+
+// Frames without config menu input before pending changes are flushed
+constexpr int SAVE_CONFIG_IDLE_FRAMES = 3 * 60;
+
+// Seconds between checkpoints while the timer runs
+constexpr uint32_t SAVE_CHECKPOINT_SECONDS = 60;
+
+// SavePayload::flags bits
+constexpr uint8_t SAVE_CHECKPOINT = 0x1;        // The checkpoint fields are set
+constexpr uint8_t SAVE_TIMER_ACTIVE = 0x2;
+constexpr uint8_t SAVE_SESSION_STARTED = 0x4;
+constexpr uint8_t SAVE_WALL_CLOCK = 0x8;        // clockSeconds was read from the RTC
+
+// Saved values, kept small and trivially copyable
+struct SavePayload {
+    uint16_t workTime;
+    uint16_t shortBreakTime;
+    uint16_t longBreakTime;
+    uint16_t sessionsPerSet;
+    uint32_t completedSessions;
+    uint32_t completedSets;
+    SessionStats stats;
+    uint8_t state;              // Interval checkpoint
+    uint8_t flags;
+    uint16_t sessionPauses;
+    uint16_t secondsRemaining;
+    uint16_t reserved;
+    uint32_t clockSeconds;      // Session clock at the checkpoint
+    uint32_t sessionStart;
+};
+
+struct SaveSlot {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t sequence;      // Incremented on each write, the newest valid slot wins
+    SavePayload payload;
+    uint16_t checksum;      // Fletcher-16 of version, sequence and payload
+    uint16_t reserved;
+};
+
+static_assert(sizeof(SaveSlot) <= SAVE_SLOT_MAX_SIZE, "Save slot too large");
+
+class SaveStore {
+public:
+    // Read both slots at boot and apply the newest valid one.
+    // Returns false (leaving ctx untouched) if there is no valid save
+    bool load(PomodoroContext& ctx);
+
+    // Continue the interval saved at the last checkpoint. Call at boot once
+    // the session clock has been restored from the history and the RTC
+    void resume(PomodoroContext& ctx);
+
+    // Call once per frame after input and timer updates
+    void update(const PomodoroContext& ctx, bool input);
+
+    // Write the block now if it differs from the saved one, the session clock aside
+    void flush(const PomodoroContext& ctx);
+
+private:
+    SavePayload _saved = {};
+    uint16_t _sequence = 0;
+    int _slot = 0;                  // Slot written by the next flush
+    bool _valid = false;            // _saved mirrors a valid SRAM slot
+    bool _pending = false;          // Config menu changes not flushed yet
+    int _idleFrames = 0;
+    ChangeKey _statsKey;            // Finished WORK intervals, reset ones included
+    ChangeKey _activeKey;           // Timer started or paused
+    PomodoroState _lastState = PomodoroState::IDLE;
+};
+
+#endif
@@ -0,0 +1,46 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Static text of each screen, composed into map cells at compile time.
+ *
+ * Titles, panel headers, labels and key hints are described once here. When
+ * a screen opens its chrome is block copied into the BG text map, and only
+ * values, the cursor and other dynamic fields are written at run time.
+ */
+#ifndef POMI_SCREEN_CHROME_H
+#define POMI_SCREEN_CHROME_H
+
+#include "pomodoro.h"
+
+constexpr int CENTER_COLUMN = BG_TEXT_COLUMNS / 2;
+
+inline constexpr BgTextLine POMODORO_CHROME_LINES[] = {
+    { PomodoroScreen::TITLE_ROW, CENTER_COLUMN, "POMI", BgTextColor::ACCENT },
+    { PomodoroScreen::STATUS_HEADER_ROW, CENTER_COLUMN, "[ STATUS ]" },
+    { PomodoroScreen::CYCLES_ROW, PomodoroScreen::LABEL_END_COLUMN, "CYCLES:", BgTextColor::NORMAL,
+      BgTextAlign::RIGHT },
+    { PomodoroScreen::COMMANDS_HEADER_ROW, CENTER_COLUMN, "[ COMMANDS ]" }
+};
+
+inline constexpr BgTextLine CONFIG_CHROME_LINES[] = {
+    { ConfigScreen::TITLE_ROW, CENTER_COLUMN, "CONFIG", BgTextColor::ACCENT },
+    { ConfigScreen::PARAMS_HEADER_ROW, CENTER_COLUMN, "[ PARAMS ]" },
+    { ConfigScreen::ITEM_ROWS[0], ConfigScreen::LABEL_END_COLUMN, "WORK:", BgTextColor::NORMAL, BgTextAlign::RIGHT },
+    { ConfigScreen::ITEM_ROWS[1], ConfigScreen::LABEL_END_COLUMN, "S.REST:", BgTextColor::NORMAL, BgTextAlign::RIGHT },
+    { ConfigScreen::ITEM_ROWS[2], ConfigScreen::LABEL_END_COLUMN, "L.REST:", BgTextColor::NORMAL, BgTextAlign::RIGHT },
+    { ConfigScreen::ITEM_ROWS[3], ConfigScreen::LABEL_END_COLUMN, "SET SIZE:", BgTextColor::NORMAL,
+      BgTextAlign::RIGHT },
+    { ConfigScreen::FOOTER_ROW, CENTER_COLUMN, "NAVIGATE:\x18\x19 ADJUST:\x1A\x1B EXIT:B" },
+    { ConfigScreen::STATS_HINT_ROW, CENTER_COLUMN, "STATS:START" }
+};
+
+inline constexpr BgTextLine STATS_CHROME_LINES[] = {
+    { StatsScreen::TITLE_ROW, CENTER_COLUMN, "STATS", BgTextColor::ACCENT },
+    { StatsScreen::CHART_HEADER_ROW, CENTER_COLUMN, "[ LAST 7 DAYS ]" },
+    { StatsScreen::FOOTER_ROW, CENTER_COLUMN, "BACK:B" }
+};
+
+inline constexpr BgTextScreen POMODORO_CHROME = composeBgTextScreen(POMODORO_CHROME_LINES);
+inline constexpr BgTextScreen CONFIG_CHROME = composeBgTextScreen(CONFIG_CHROME_LINES);
+inline constexpr BgTextScreen STATS_CHROME = composeBgTextScreen(STATS_CHROME_LINES);
+
+#endif
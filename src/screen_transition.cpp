@@ -0,0 +1,73 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Screen transition implementation
+ */
+#include "screen_transition.h"
+
+#include "bn_fixed.h"
+#include "bn_bg_palettes.h"
+#include "bn_sprite_palettes.h"
+
+#include "bg_text.h"
+
+namespace {
+    // 280896 CPU cycles per frame, 64 per timer tick
+    constexpr int FRAME_TICKS = 280896 / 64;
+    constexpr int BUDGET_TICKS = FRAME_TICKS * POMI_TRANSITION_CPU_PERCENT / 100;
+}
+
+void ScreenTransition::beginFrame() {
+    _frameTimer.restart();
+    _frameStages = 0;
+}
+
+void ScreenTransition::setTarget(ScreenId screen, BgText& bgText) {
+    if (screen != _target) {
+        // A transition already under way restarts from its chrome
+        _target = screen;
+        _stage = TransitionStage::CHROME;
+        bgText.setHeld(true);
+    }
+
+    // Fade out while building, back in once the new screen is shown
+    if (POMI_TRANSITION_FADE_FRAMES) {
+        int fadeFrame = _fadeFrame + (building() ? 1 : -1);
+
+        if (fadeFrame >= 0 && fadeFrame <= POMI_TRANSITION_FADE_FRAMES) {
+            _fadeFrame = fadeFrame;
+            applyFade();
+        }
+    }
+}
+
+bool ScreenTransition::nextStage(TransitionStage& stage, BgText& bgText) {
+    if (!building()) {
+        return false;
+    }
+
+    // The old screen is only swapped out once it has faded out
+    if (_stage == TransitionStage::SWAP && _fadeFrame < POMI_TRANSITION_FADE_FRAMES) {
+        return false;
+    }
+
+    if (_frameStages > 0 && _frameTimer.elapsed_ticks() >= BUDGET_TICKS) {
+        return false;
+    }
+
+    ++_frameStages;
+    stage = _stage;
+
+    if (_stage == TransitionStage::SWAP) {
+        // The map built behind the old screen is uploaded this frame
+        bgText.setHeld(false);
+    }
+
+    _stage = static_cast<TransitionStage>(static_cast<int>(_stage) + 1);
+    return true;
+}
+
+void ScreenTransition::applyFade() {
+    bn::fixed intensity = bn::fixed(_fadeFrame) / POMI_TRANSITION_FADE_FRAMES;
+    bn::bg_palettes::set_fade(bn::color(0, 0, 0), intensity);
+    bn::sprite_palettes::set_fade(bn::color(0, 0, 0), intensity);
+}
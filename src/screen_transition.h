@@ -0,0 +1,95 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Multi-frame screen transitions.
+ *
+ * Opening another screen used to rebuild all of its text, release the old
+ * sprites and regenerate the new ones in one frame. A transition instead
+ * builds the next screen in stages, behind the one on display:
+ *
+ *   CHROME  the precomposed static text is loaded into the BG text map
+ *   FIELDS  values, the cursor and other dynamic fields are written
+ *   SWAP    the old screen's sprites are released, the new ones generated,
+ *           and the BG text map is uploaded
+ *
+ * The BG text map is held (see BgText::setHeld) from the start of the
+ * transition to the swap, so the old screen stays on display until the new
+ * one is complete. Several stages can run in the same frame, but a stage is
+ * only started while less than POMI_TRANSITION_CPU_PERCENT of the frame has
+ * gone by since beginFrame(), the logic stage included; the first stage of a
+ * frame always runs.
+ *
+ * With POMI_TRANSITION_FADE_FRAMES the text and sprites fade to black while
+ * the next screen is built, and back in after the swap.
+ */
+#ifndef POMI_SCREEN_TRANSITION_H
+#define POMI_SCREEN_TRANSITION_H
+
+#include "bn_timer.h"
+
+class BgText;
+
+// Share of a frame the stages of a transition may take
+#ifndef POMI_TRANSITION_CPU_PERCENT
+    #define POMI_TRANSITION_CPU_PERCENT 50
+#endif
+
+// Frames to fade out and in around the swap (0 disables the fade)
+#ifndef POMI_TRANSITION_FADE_FRAMES
+    #define POMI_TRANSITION_FADE_FRAMES 0
+#endif
+
+static_assert(POMI_TRANSITION_CPU_PERCENT > 0 && POMI_TRANSITION_CPU_PERCENT <= 100, "Invalid transition budget");
+
+enum class ScreenId {
+    NONE,
+    POMODORO,
+    CONFIG,
+    STATS
+};
+
+enum class TransitionStage {
+    CHROME,
+    FIELDS,
+    SWAP,
+    DONE
+};
+
+class ScreenTransition {
+public:
+    // Screen on display, or being built
+    [[nodiscard]] ScreenId target() const {
+        return _target;
+    }
+
+    // True while the previous screen is still on display
+    [[nodiscard]] bool building() const {
+        return _stage != TransitionStage::DONE;
+    }
+
+    // True until the screen has faded back in, the fade only steps on renders
+    [[nodiscard]] bool fading() const {
+        return _fadeFrame != 0;
+    }
+
+    // Start timing the frame's budget, call at the top of the main loop
+    void beginFrame();
+
+    // Start building the given screen unless it is already the target, and
+    // step the fade. Call on render frames before running the stages
+    void setTarget(ScreenId screen, BgText& bgText);
+
+    // Next stage to run this frame. Returns false once the transition is done
+    // or the frame's budget is spent
+    bool nextStage(TransitionStage& stage, BgText& bgText);
+
+private:
+    bn::timer _frameTimer;
+    ScreenId _target = ScreenId::NONE;
+    TransitionStage _stage = TransitionStage::DONE;
+    int _frameStages = 0;       // Stages run this frame
+    int _fadeFrame = 0;         // 0 shows the screen, POMI_TRANSITION_FADE_FRAMES is black
+
+    void applyFade();
+};
+
+#endif
@@ -0,0 +1,55 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Hardware seconds timebase implementation
+ */
+#include "seconds_counter.h"
+
+#include <cstdint>
+
+namespace {
+    // Timer registers: TMxCNT_L (counter / reload) and TMxCNT_H (control)
+    constexpr uintptr_t TIMER_BASE = 0x04000100;
+
+    constexpr uint16_t TIMER_PRESCALER_1024 = 0x0003;
+    constexpr uint16_t TIMER_CASCADE = 0x0004;
+    constexpr uint16_t TIMER_ENABLE = 0x0080;
+
+    // Timers 2 and 3 are Butano's, see seconds_counter.h
+    constexpr int PRESCALE_TIMER = 0;
+    constexpr int CASCADE_TIMER = 1;
+
+    // 16.78 MHz / 1024 = 16384 Hz, so 16384 counts per overflow is one second
+    constexpr uint16_t TIMER_ONE_SECOND_RELOAD = 65536 - 16384;
+
+    volatile uint16_t& counterRegister(int timer) {
+        return *reinterpret_cast<volatile uint16_t*>(TIMER_BASE + timer * 4);
+    }
+
+    volatile uint16_t& controlRegister(int timer) {
+        return *reinterpret_cast<volatile uint16_t*>(TIMER_BASE + timer * 4 + 2);
+    }
+}
+
+void SecondsCounter::restart() {
+    // Stop both timers; enabling a timer again reloads its counter
+    controlRegister(PRESCALE_TIMER) = 0;
+    controlRegister(CASCADE_TIMER) = 0;
+    
+    counterRegister(PRESCALE_TIMER) = TIMER_ONE_SECOND_RELOAD;
+    counterRegister(CASCADE_TIMER) = 0;
+    
+    // Start the seconds counter first so no overflow is missed
+    controlRegister(CASCADE_TIMER) = TIMER_CASCADE | TIMER_ENABLE;
+    controlRegister(PRESCALE_TIMER) = TIMER_PRESCALER_1024 | TIMER_ENABLE;
+    
+    _lastCount = 0;
+}
+
+int SecondsCounter::poll() {
+    unsigned count = counterRegister(CASCADE_TIMER);
+    
+    // 16-bit wrap-safe difference
+    int elapsed = (count - _lastCount) & 0xFFFF;
+    _lastCount = count;
+    return elapsed;
+}
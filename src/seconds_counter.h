@@ -0,0 +1,40 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Optional hardware seconds timebase.
+ *
+ * Two cascaded GBA timers count whole seconds: the first one runs at
+ * 16384 Hz and overflows exactly once per second, and the second one counts
+ * those overflows in hardware. Polling for elapsed seconds is then a single
+ * register read, with no tick math in the main loop.
+ *
+ * Enable it by adding -DPOMI_HW_SECONDS=1 to USERFLAGS. No timer pair is
+ * free in the default build: Butano runs bn::timer and the CPU usage
+ * counter on timers 2 and 3, and direct sound audio backends (maxmod, aas)
+ * drive their mixers from timers 0 and 1. The counter therefore takes
+ * timers 0 and 1, and only builds without maxmod (make POMI_AUDIO=null).
+ */
+#ifndef POMI_SECONDS_COUNTER_H
+#define POMI_SECONDS_COUNTER_H
+
+#include "psg_audio.h"
+
+#ifndef POMI_HW_SECONDS
+    #define POMI_HW_SECONDS 0
+#endif
+
+static_assert(!POMI_HW_SECONDS || POMI_AUDIO_NULL,
+              "Timers 0 and 1 drive the direct sound mixer and Butano uses 2 and 3, build with POMI_AUDIO=null");
+
+class SecondsCounter {
+public:
+    // Restart the counter at a whole second boundary
+    void restart();
+
+    // Number of whole seconds elapsed since the last call (or restart)
+    [[nodiscard]] int poll();
+
+private:
+    unsigned _lastCount = 0;
+};
+
+#endif
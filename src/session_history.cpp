@@ -0,0 +1,217 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Session history implementation
+ */
+#include "session_history.h"
+
+#include <cstddef>
+
+#include "bn_sram.h"
+
+#include "checksum.h"
+#include "varint.h"
+
+namespace {
+    constexpr uint32_t HISTORY_MAGIC = 0x54534948;  // "HIST"
+    constexpr uint16_t HISTORY_VERSION = 1;
+
+    constexpr int headerOffset(int slot) {
+        return HISTORY_HEADERS_OFFSET + slot * HISTORY_HEADER_MAX_SIZE;
+    }
+
+    uint16_t headerChecksum(const HistoryHeader& header) {
+        return fletcher16(&header.version,
+                          int(offsetof(HistoryHeader, checksum) - offsetof(HistoryHeader, version)));
+    }
+
+    // Ring offset after moving forward by the given number of bytes
+    int ringAdvance(int position, int bytes) {
+        position += bytes;
+
+        if (position >= HISTORY_CAPACITY) {
+            position -= HISTORY_CAPACITY;
+        }
+
+        return position;
+    }
+
+    bool validHeader(const HistoryHeader& header) {
+        if (header.magic != HISTORY_MAGIC || header.version != HISTORY_VERSION ||
+                header.checksum != headerChecksum(header)) {
+            return false;
+        }
+
+        return header.head < HISTORY_CAPACITY && header.tail < HISTORY_CAPACITY &&
+               header.usedBytes <= HISTORY_CAPACITY && (header.count == 0) == (header.usedBytes == 0) &&
+               ringAdvance(header.tail, header.usedBytes) == header.head;
+    }
+
+    // Sequence numbers wrap, a header is newer if it is less than half the range ahead
+    bool newerSequence(uint16_t sequence, uint16_t other) {
+        return static_cast<int16_t>(sequence - other) > 0;
+    }
+
+    uint8_t readByte(int position) {
+        uint8_t value;
+        bn::sram::read_offset(value, HISTORY_DATA_OFFSET + position);
+        return value;
+    }
+
+    void writeBytes(int position, const uint8_t* bytes, int size) {
+        for (int index = 0; index < size; ++index) {
+            bn::sram::write_offset(bytes[index], HISTORY_DATA_OFFSET + position);
+            position = ringAdvance(position, 1);
+        }
+    }
+
+    // Same encoding as putVarint(), read from the ring
+    uint32_t readVarint(int& position) {
+        uint32_t value = 0;
+
+        for (int shift = 0; shift < VARINT_MAX_BYTES * 7; shift += 7) {
+            uint8_t byte = readByte(position);
+            position = ringAdvance(position, 1);
+            value |= uint32_t(byte & 0x7F) << shift;
+
+            if (!(byte & 0x80)) {
+                break;
+            }
+        }
+
+        return value;
+    }
+
+    // Small negative and positive values both encode to small varints
+    constexpr uint32_t zigzag(int value) {
+        return (uint32_t(value) << 1) ^ uint32_t(value >> 31);
+    }
+
+    constexpr int unzigzag(uint32_t value) {
+        return int(value >> 1) ^ -int(value & 1);
+    }
+
+    constexpr int STATE_BITS = 0x3;
+    constexpr int PAUSED_BIT = 0x4;
+    constexpr int RESET_BIT = 0x8;
+}
+
+bool SessionHistory::load(PomodoroContext& ctx) {
+    HistoryHeader headers[HISTORY_HEADERS];
+    int newest = -1;
+
+    for (int index = 0; index < HISTORY_HEADERS; ++index) {
+        bn::sram::read_offset(headers[index], headerOffset(index));
+
+        if (validHeader(headers[index]) &&
+                (newest < 0 || newerSequence(headers[index].sequence, headers[newest].sequence))) {
+            newest = index;
+        }
+    }
+
+    if (newest < 0) {
+        _header = HistoryHeader();
+        _nextHeader = 0;
+        return false;
+    }
+
+    _header = headers[newest];
+    _nextHeader = (newest + 1) % HISTORY_HEADERS;
+
+    // Keep the session clock increasing across power cycles
+    ctx.clockSeconds = _header.lastEnd;
+    ctx.clock.reset(ctx.timer.elapsed_ticks());
+    return true;
+}
+
+void SessionHistory::update(PomodoroContext& ctx) {
+    if (ctx.finishedSession) {
+        append(*ctx.finishedSession);
+        ctx.finishedSession.reset();
+    }
+}
+
+void SessionHistory::append(const SessionRecord& record) {
+    int state = static_cast<int>(record.state) - static_cast<int>(PomodoroState::WORK);
+    int plannedMinutes = splitClock(record.plannedSeconds).minutes;
+    uint32_t startDelta = _header.count ? record.startTime - _header.lastStart : 0;
+
+    uint8_t bytes[HISTORY_MAX_RECORD_BYTES];
+    int size = 0;
+    bytes[size++] = static_cast<uint8_t>((state & STATE_BITS) | (record.paused ? PAUSED_BIT : 0) |
+                                         (record.reset ? RESET_BIT : 0));
+    size += putVarint(bytes + size, startDelta);
+    size += putVarint(bytes + size, static_cast<uint32_t>(plannedMinutes));
+    size += putVarint(bytes + size, zigzag(record.actualSeconds - plannedMinutes * 60));
+
+    if (HISTORY_CAPACITY - _header.usedBytes < size) {
+        while (HISTORY_CAPACITY - _header.usedBytes < size) {
+            dropOldest();
+        }
+
+        // Commit the new tail before its old bytes are overwritten
+        writeHeader();
+    }
+
+    writeBytes(_header.head, bytes, size);
+
+    if (_header.count == 0) {
+        _header.tailStart = record.startTime;
+    }
+
+    _header.head = static_cast<uint16_t>(ringAdvance(_header.head, size));
+    _header.usedBytes = static_cast<uint16_t>(_header.usedBytes + size);
+    _header.count = static_cast<uint16_t>(_header.count + 1);
+    _header.lastStart = record.startTime;
+    _header.lastEnd = record.startTime + static_cast<uint32_t>(record.actualSeconds);
+    writeHeader();
+}
+
+int SessionHistory::decode(int position, SessionRecord& record, uint32_t& startDelta) {
+    int flags = readByte(position);
+    position = ringAdvance(position, 1);
+
+    int state = flags & STATE_BITS;
+
+    if (state > 2) {
+        state = 2;
+    }
+
+    record.state = static_cast<PomodoroState>(static_cast<int>(PomodoroState::WORK) + state);
+    record.paused = flags & PAUSED_BIT;
+    record.reset = flags & RESET_BIT;
+    startDelta = readVarint(position);
+    record.plannedSeconds = static_cast<int>(readVarint(position)) * 60;
+    record.actualSeconds = record.plannedSeconds + unzigzag(readVarint(position));
+    return position;
+}
+
+void SessionHistory::dropOldest() {
+    SessionRecord record;
+    uint32_t startDelta;
+    int next = decode(_header.tail, record, startDelta);
+    int size = next - _header.tail;
+
+    if (size <= 0) {
+        size += HISTORY_CAPACITY;
+    }
+
+    _header.tail = static_cast<uint16_t>(next);
+    _header.usedBytes = static_cast<uint16_t>(_header.usedBytes - size);
+    _header.count = static_cast<uint16_t>(_header.count - 1);
+
+    // The next record's delta is relative to the dropped one
+    if (_header.count > 0) {
+        decode(next, record, startDelta);
+        _header.tailStart += startDelta;
+    }
+}
+
+void SessionHistory::writeHeader() {
+    _header.magic = HISTORY_MAGIC;
+    _header.version = HISTORY_VERSION;
+    _header.sequence = static_cast<uint16_t>(_header.sequence + 1);
+    _header.checksum = headerChecksum(_header);
+
+    bn::sram::write_offset(_header, headerOffset(_nextHeader));
+    _nextHeader = (_nextHeader + 1) % HISTORY_HEADERS;
+}
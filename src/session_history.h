@@ -0,0 +1,96 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Session history ring buffer in SRAM.
+ *
+ * Each finished interval is stored as a variable-length record:
+ *
+ *   flags        1 byte: state (2 bits), paused, reset
+ *   start delta  varint: seconds since the previous record's start
+ *   planned      varint: planned duration in minutes
+ *   overrun      zigzag varint: actual duration minus planned duration, in seconds
+ *
+ * A typical record takes 5 bytes, so several thousand intervals fit. The
+ * oldest records are dropped when the ring is full. Appending writes only the
+ * new record bytes and one of two alternating checksummed headers.
+ */
+#ifndef POMI_SESSION_HISTORY_H
+#define POMI_SESSION_HISTORY_H
+
+#include <cstdint>
+
+#include "pomodoro_core.h"
+#include "sram_layout.h"
+
+// Largest encoded record: flags, three varints of up to 5 bytes
+constexpr int HISTORY_MAX_RECORD_BYTES = 16;
+
+struct HistoryHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t sequence;      // Incremented on each write, the newest valid header wins
+    uint16_t head;          // Ring offset where the next record is written
+    uint16_t tail;          // Ring offset of the oldest record
+    uint16_t usedBytes;
+    uint16_t count;
+    uint32_t tailStart;     // Start time of the oldest record
+    uint32_t lastStart;     // Start time of the newest record, base of the next delta
+    uint32_t lastEnd;       // End time of the newest record, the session clock resumes from it
+    uint16_t checksum;      // Fletcher-16 of everything from version up to here
+    uint16_t reserved;
+};
+
+static_assert(sizeof(HistoryHeader) <= HISTORY_HEADER_MAX_SIZE, "History header too large");
+static_assert(HISTORY_CAPACITY <= 65535, "History offsets are 16 bit");
+
+class SessionHistory {
+public:
+    // Read the newest valid header and resume the session clock from the last
+    // record. Returns false (starting an empty history) if there is none
+    bool load(PomodoroContext& ctx);
+
+    // Append the interval finished this frame, if any. Call once per frame
+    void update(PomodoroContext& ctx);
+
+    // Append a record in O(1): its own bytes plus one header write
+    void append(const SessionRecord& record);
+
+    [[nodiscard]] int count() const {
+        return _header.count;
+    }
+
+    [[nodiscard]] int usedBytes() const {
+        return _header.usedBytes;
+    }
+
+    // Call visitor(const SessionRecord&) for each record, oldest first
+    template<typename Visitor>
+    void forEach(Visitor&& visitor) const {
+        int position = _header.tail;
+        uint32_t startTime = _header.tailStart;
+
+        for (int index = 0; index < _header.count; ++index) {
+            SessionRecord record;
+            uint32_t delta;
+            position = decode(position, record, delta);
+
+            if (index > 0) {
+                startTime += delta;
+            }
+
+            record.startTime = startTime;
+            visitor(record);
+        }
+    }
+
+private:
+    HistoryHeader _header = {};
+    int _nextHeader = 0;        // Header slot written by the next append
+
+    // Decode the record at a ring offset, returning the offset of the next one
+    static int decode(int position, SessionRecord& record, uint32_t& startDelta);
+
+    void dropOldest();
+    void writeHeader();
+};
+
+#endif
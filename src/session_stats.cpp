@@ -0,0 +1,70 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Running session statistics implementation
+ */
+#include "session_stats.h"
+
+#include "pomodoro_core.h"
+
+void SessionStats::roll(uint32_t newDay) {
+    if (newDay <= day) {
+        return;
+    }
+
+    uint32_t shift = newDay - day;
+
+    for (int index = STATS_DAYS - 1; index >= 0; --index) {
+        dayFocusSeconds[index] = uint32_t(index) >= shift ? dayFocusSeconds[index - shift] : 0;
+    }
+
+    day = newDay;
+}
+
+void SessionStats::add(const SessionRecord& record, uint32_t endDay) {
+    roll(endDay);
+
+    if (record.state != PomodoroState::WORK) {
+        return;
+    }
+
+    // The session clock only moves forward, so the interval lands in the newest bucket
+    if (endDay == day) {
+        dayFocusSeconds[0] += static_cast<uint32_t>(record.focusSeconds);
+    }
+
+    ++workSessions;
+    interruptions += static_cast<uint32_t>(record.pauses) + (record.reset ? 1 : 0);
+
+    if (record.reset) {
+        return;
+    }
+
+    // Several intervals on the same day keep the streak as it is
+    if (currentStreak == 0 || endDay > streakDay + 1) {
+        currentStreak = 1;
+    } else if (endDay == streakDay + 1) {
+        ++currentStreak;
+    }
+
+    streakDay = endDay;
+
+    if (currentStreak > bestStreak) {
+        bestStreak = currentStreak;
+    }
+}
+
+int SessionStats::streak(uint32_t today) const {
+    if (currentStreak == 0 || today > streakDay + 1) {
+        return 0;
+    }
+
+    return currentStreak;
+}
+
+int SessionStats::interruptionsPerSessionTenths() const {
+    if (workSessions == 0) {
+        return 0;
+    }
+
+    return static_cast<int>((interruptions * 10 + workSessions / 2) / workSessions);
+}
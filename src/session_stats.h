@@ -0,0 +1,49 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Running session statistics.
+ *
+ * Aggregates are folded in once per finished interval, so the statistics
+ * screen never has to scan the session history. The struct is trivially
+ * copyable and saved with the config block.
+ */
+#ifndef POMI_SESSION_STATS_H
+#define POMI_SESSION_STATS_H
+
+#include <cstdint>
+
+// Daily focus buckets kept for the chart
+constexpr int STATS_DAYS = 7;
+
+constexpr uint32_t SECONDS_PER_DAY = 24 * 60 * 60;
+
+// Day index of a session clock time: a calendar day when the clock follows the
+// RTC, otherwise a 24 hour period counted from the first boot
+constexpr uint32_t sessionDay(uint32_t clockSeconds) {
+    return clockSeconds / SECONDS_PER_DAY;
+}
+
+struct SessionRecord;
+
+struct SessionStats {
+    uint32_t day = 0;                           // Day of dayFocusSeconds[0]
+    uint32_t dayFocusSeconds[STATS_DAYS] = {};  // [n] is n days before day
+    uint32_t workSessions = 0;                  // WORK intervals ended, completed or reset
+    uint32_t interruptions = 0;                 // Pauses and resets over those intervals
+    uint32_t streakDay = 0;                     // Last day with a completed WORK interval
+    uint16_t currentStreak = 0;                 // Consecutive days with a completed WORK interval up to streakDay
+    uint16_t bestStreak = 0;
+
+    // Move the daily buckets forward to the given day, dropping the oldest ones
+    void roll(uint32_t newDay);
+
+    // Fold a finished interval ending on the given day into the aggregates
+    void add(const SessionRecord& record, uint32_t endDay);
+
+    // Streak as seen on the given day: broken if no focus yesterday or today
+    [[nodiscard]] int streak(uint32_t today) const;
+
+    // Average interruptions per WORK interval, in tenths
+    [[nodiscard]] int interruptionsPerSessionTenths() const;
+};
+
+#endif
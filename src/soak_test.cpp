@@ -0,0 +1,287 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Soak test implementation
+ */
+#include "soak_test.h"
+
+#if POMI_TIME_WARP
+
+#include "bn_core.h"
+#include "bn_log.h"
+#include "bn_assert.h"
+#include "bn_sprites.h"
+#include "bn_sprite_tiles.h"
+
+#include "clock_time.h"
+#include "save_store.h"
+#include "session_history.h"
+
+static_assert(!POMI_HW_SECONDS, "Hardware timer seconds don't follow the warped ticks");
+
+namespace {
+    // Frames taken by a simulated hour
+    constexpr int FRAMES_PER_HOUR = 60 * 3600 / POMI_TIME_WARP;
+
+    // Scripted keys are a few frames apart, so transitions finish in between
+    constexpr int KEY_GAP_FRAMES = 4;
+
+    // Average frames of a running interval between two pauses, resets and
+    // trips to the config menu
+    constexpr int PAUSE_FRAMES = FRAMES_PER_HOUR / 2;
+    constexpr int RESET_FRAMES = FRAMES_PER_HOUR * 2;
+    constexpr int CONFIG_FRAMES = FRAMES_PER_HOUR * 4;
+
+    constexpr uint32_t REPORT_SECONDS = POMI_SOAK_REPORT_HOURS * 3600;
+
+    bool timedState(PomodoroState state) {
+        return state == PomodoroState::WORK || state == PomodoroState::SHORT_BREAK ||
+               state == PomodoroState::LONG_BREAK;
+    }
+
+    bool validDuration(int seconds) {
+        return seconds >= 60 && seconds <= MAX_CONFIG_MINUTES * 60 && seconds % 60 == 0;
+    }
+
+    bool sameRecord(const SessionRecord& a, const SessionRecord& b) {
+        return a.state == b.state && a.startTime == b.startTime && a.plannedSeconds == b.plannedSeconds &&
+               a.actualSeconds == b.actualSeconds && a.paused == b.paused && a.reset == b.reset;
+    }
+
+    int percent(bn::fixed usage) {
+        return (usage * 100).right_shift_integer();
+    }
+}
+
+void SoakTest::begin(const PomodoroContext& ctx) {
+    _completedSessions = ctx.completedSessions;
+    _completedSets = ctx.completedSets;
+    _clockSeconds = ctx.clockSeconds;
+    _startClock = ctx.clockSeconds;
+    _reportClock = ctx.clockSeconds;
+    _lowFreeTiles = bn::sprite_tiles::available_tiles_count();
+
+    BN_LOG("soak start x", POMI_TIME_WARP, " sessions: ", ctx.completedSessions, " sets: ", ctx.completedSets);
+}
+
+KeyInput SoakTest::frame(const PomodoroContext& ctx, KeyInput live) {
+    sample();
+
+    if (live.any() || live.held) {
+        return live;
+    }
+
+    KeyInput keys;
+
+    if (_waitFrames > 0) {
+        --_waitFrames;
+        return keys;
+    }
+
+    keys.pressed = scriptedKey(ctx);
+    return keys;
+}
+
+void SoakTest::check(const PomodoroContext& ctx) {
+    const PomodoroConfig& config = ctx.config;
+    BN_ASSERT(validDuration(config.workTime) && validDuration(config.shortBreakTime) &&
+              validDuration(config.longBreakTime), "soak: duration out of range");
+    BN_ASSERT(config.sessionsPerSet >= 1 && config.sessionsPerSet <= MAX_CONFIG_SESSIONS,
+              "soak: sessions per set out of range: ", config.sessionsPerSet);
+    BN_ASSERT(ctx.configSelection >= 0 && ctx.configSelection < 4, "soak: config selection: ", ctx.configSelection);
+    BN_ASSERT(!ctx.timerActive || timedState(ctx.state), "soak: timer running in state ", int(ctx.state));
+
+    if (timedState(ctx.state)) {
+        BN_ASSERT(ctx.secondsRemaining >= 0 && ctx.secondsRemaining <= stateDuration(ctx),
+                  "soak: countdown out of range: ", ctx.secondsRemaining);
+    }
+
+    BN_ASSERT(ctx.clockSeconds >= _clockSeconds, "soak: session clock went back");
+    BN_ASSERT(ctx.completedSets <= ctx.completedSessions, "soak: more sets than sessions");
+
+    // A frame ends at most one interval
+    int sessions = ctx.completedSessions - _completedSessions;
+    int sets = ctx.completedSets - _completedSets;
+    BN_ASSERT(sessions == 0 || sessions == 1, "soak: sessions counted: ", sessions);
+    BN_ASSERT(sets == 0 || (sets == 1 && sessions == 1), "soak: sets counted: ", sets);
+
+    if (sessions) {
+        // A set ends on multiples of the sessions per set, however often it was changed
+        bool setEnded = ctx.completedSessions % config.sessionsPerSet == 0;
+        BN_ASSERT(sets == (setEnded ? 1 : 0), "soak: set counting after session ", ctx.completedSessions);
+        BN_ASSERT(ctx.state == (setEnded ? PomodoroState::LONG_BREAK : PomodoroState::SHORT_BREAK),
+                  "soak: wrong break after session ", ctx.completedSessions);
+        BN_ASSERT(ctx.finishedSession && !ctx.finishedSession->reset, "soak: completed session not recorded");
+    }
+
+    if (ctx.finishedSession) {
+        const SessionRecord& record = *ctx.finishedSession;
+        BN_ASSERT(timedState(record.state), "soak: record of state ", int(record.state));
+        BN_ASSERT(record.focusSeconds >= 0 && record.focusSeconds <= record.plannedSeconds,
+                  "soak: focus time out of range: ", record.focusSeconds);
+        BN_ASSERT(record.reset || record.focusSeconds == record.plannedSeconds, "soak: completed interval cut short");
+        BN_ASSERT(record.paused == (record.pauses > 0), "soak: pause flag mismatch");
+
+        // Both clocks count the same ticks from a different phase, so the
+        // countdown may be up to a second ahead
+        if (record.startTime >= _startClock) {
+            BN_ASSERT(record.actualSeconds + 1 >= record.focusSeconds, "soak: interval shorter than its focus time");
+        }
+
+        _finished = record;
+        ++_records;
+    }
+
+    _completedSessions = ctx.completedSessions;
+    _completedSets = ctx.completedSets;
+    _clockSeconds = ctx.clockSeconds;
+}
+
+void SoakTest::checkSaved(const PomodoroContext& ctx, const SessionHistory& history) {
+    if (_finished) {
+        const SessionRecord& expected = *_finished;
+
+        // Read the SRAM back into scratch objects, as at boot
+        PomodoroContext saved;
+        SessionHistory savedHistory;
+        BN_ASSERT(savedHistory.load(saved), "soak: no valid history header");
+        BN_ASSERT(savedHistory.count() == history.count() && savedHistory.usedBytes() == history.usedBytes(),
+                  "soak: history header out of date");
+        BN_ASSERT(saved.clockSeconds == expected.startTime + static_cast<uint32_t>(expected.actualSeconds),
+                  "soak: history end time mismatch");
+
+        // Decoding the whole ring takes a few frames' worth of CPU time
+        if (_records % SOAK_SCAN_RECORDS == 0) {
+            SessionRecord newest;
+            bool valid = true;
+
+            savedHistory.forEach([&newest, &valid](const SessionRecord& record) {
+                valid = valid && validDuration(record.plannedSeconds) && record.actualSeconds >= 0;
+                newest = record;
+            });
+
+            BN_ASSERT(valid, "soak: invalid record in the history ring");
+            BN_ASSERT(sameRecord(newest, expected), "soak: newest history record mismatch");
+            _scanned = true;
+        }
+
+        // Completed intervals change state, which always flushes the save
+        if (!expected.reset) {
+            SaveStore saveStore;
+            BN_ASSERT(saveStore.load(saved), "soak: no valid save");
+            BN_ASSERT(saved.completedSessions == ctx.completedSessions && saved.completedSets == ctx.completedSets,
+                      "soak: saved counters out of date");
+            BN_ASSERT(saved.config.workTime == ctx.config.workTime &&
+                      saved.config.shortBreakTime == ctx.config.shortBreakTime &&
+                      saved.config.longBreakTime == ctx.config.longBreakTime &&
+                      saved.config.sessionsPerSet == ctx.config.sessionsPerSet, "soak: saved config out of date");
+        }
+
+        _finished.reset();
+    }
+
+    if (ctx.clockSeconds - _reportClock >= REPORT_SECONDS) {
+        _reportClock = ctx.clockSeconds;
+        report(ctx);
+    }
+}
+
+int SoakTest::random(int range) {
+    _random ^= _random << 13;
+    _random ^= _random >> 17;
+    _random ^= _random << 5;
+    return static_cast<int>(_random % static_cast<uint32_t>(range));
+}
+
+uint16_t SoakTest::scriptedKey(const PomodoroContext& ctx) {
+    int gap = KEY_GAP_FRAMES + random(KEY_GAP_FRAMES);
+
+    if (ctx.state == PomodoroState::CONFIG) {
+        // Walk the settings at random, now and then via the statistics screen
+        _waitFrames = gap;
+        int choice = random(16);
+
+        if (choice == 0) {
+            return KeyInput::START;
+        } else if (choice < 3) {
+            return KeyInput::B;
+        } else if (choice < 6) {
+            return choice == 3 ? KeyInput::UP : KeyInput::DOWN;
+        }
+
+        return choice % 2 ? KeyInput::RIGHT : KeyInput::LEFT;
+    }
+
+    if (ctx.state == PomodoroState::STATS) {
+        _waitFrames = gap;
+        return KeyInput::B;
+    }
+
+    // Start standby, the next interval or a paused one
+    if (!ctx.timerActive) {
+        _waitFrames = gap;
+        return KeyInput::A;
+    }
+
+    // Pauses last up to a simulated quarter hour
+    if (random(PAUSE_FRAMES) == 0) {
+        _waitFrames = gap + random(FRAMES_PER_HOUR / 4);
+        return KeyInput::A;
+    }
+
+    if (random(RESET_FRAMES) == 0) {
+        _waitFrames = gap;
+        return KeyInput::B;
+    }
+
+    // Leaving for the menu resets the interval, the set goes on with the new settings
+    if (random(CONFIG_FRAMES) == 0) {
+        _waitFrames = gap;
+        return KeyInput::SELECT;
+    }
+
+    return 0;
+}
+
+void SoakTest::sample() {
+    // The frame after a history scan is an outlier by design
+    if (_scanned) {
+        _scanned = false;
+    } else {
+        bn::fixed cpu = bn::core::last_cpu_usage();
+
+        if (cpu > _peakCpu) {
+            _peakCpu = cpu;
+        }
+    }
+
+    int sprites = bn::sprites::used_sprites_count();
+    int tiles = bn::sprite_tiles::used_tiles_count();
+    int tileItems = bn::sprite_tiles::used_items_count();
+    int freeTiles = bn::sprite_tiles::available_tiles_count();
+
+    if (sprites > _peakSprites) {
+        _peakSprites = sprites;
+    }
+
+    if (tiles > _peakTiles) {
+        _peakTiles = tiles;
+    }
+
+    if (tileItems > _peakTileItems) {
+        _peakTileItems = tileItems;
+    }
+
+    if (freeTiles < _lowFreeTiles) {
+        _lowFreeTiles = freeTiles;
+    }
+}
+
+void SoakTest::report(const PomodoroContext& ctx) {
+    BN_LOG("soak ", int((ctx.clockSeconds - _startClock) / 3600), "h x", POMI_TIME_WARP,
+           " sessions: ", ctx.completedSessions, " sets: ", ctx.completedSets, " records: ", _records,
+           " cpu peak: ", percent(_peakCpu), "% sprites peak: ", _peakSprites,
+           " tiles: ", bn::sprite_tiles::used_tiles_count(), " peak: ", _peakTiles,
+           " tile items peak: ", _peakTileItems, " free tiles low: ", _lowFreeTiles);
+}
+
+#endif
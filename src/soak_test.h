@@ -0,0 +1,129 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Time-warp soak test, for long-run behavior on real hardware.
+ *
+ * POMI_TIME_WARP builds multiply the ticks read from ctx.timer by the given
+ * factor (see TickClock), so the session clock and every countdown run that
+ * many times faster: at 60 a work day of sets takes 8 minutes, at 3600 a
+ * simulated hour takes a second. The 32-bit tick counter wraps
+ * every few minutes at 60, every few seconds at 3600.
+ *
+ * The soak test then drives the timer by itself: it starts every interval,
+ * pauses, resets and opens the config menu at random, changes the settings,
+ * sessions per set included, in the middle of a set and visits the
+ * statistics screen. Live keys still pass through. Each frame it asserts the
+ * state machine invariants (countdown range, session and set counting,
+ * monotonic session clock, settings range) and checks every finished
+ * interval; the SRAM history header is reloaded after each of them, the save
+ * after each completed one, and every SOAK_SCAN_RECORDS records the whole
+ * history ring is decoded again.
+ *
+ * The peak CPU usage, hardware sprites, sprite tiles and sprite tile
+ * allocations seen since the start are logged every
+ * POMI_SOAK_REPORT_HOURS simulated hours, with the tiles used at the time
+ * and the fewest tiles left free, so leaks and VRAM fragmentation show up as
+ * numbers that keep going up. Add -DBN_CFG_LOG_ENABLED=true for the log and
+ * keep asserts enabled. Soak builds never sleep.
+ *
+ * Otherwise SoakTest is an empty inline pass-through.
+ */
+#ifndef POMI_SOAK_TEST_H
+#define POMI_SOAK_TEST_H
+
+#include <cstdint>
+
+#include "input_trace.h"
+#include "platform.h"
+
+constexpr bool SOAK_TEST = POMI_TIME_WARP > 0;
+
+static_assert(!SOAK_TEST || (POMI_TIME_WARP >= 2 && POMI_TIME_WARP <= 3600), "Invalid time warp factor");
+static_assert(!SOAK_TEST || !POMI_HOST, "The host simulation scripts its own input");
+static_assert(!SOAK_TEST || !INPUT_TRACE, "Input traces run at the real speed");
+
+struct PomodoroContext;
+class SessionHistory;
+
+#if POMI_TIME_WARP
+
+#include "bn_fixed.h"
+#include "bn_optional.h"
+
+#include "pomodoro_core.h"
+
+#ifndef POMI_SOAK_REPORT_HOURS
+    #define POMI_SOAK_REPORT_HOURS 8
+#endif
+
+// Finished intervals between two full decodes of the SRAM history
+constexpr int SOAK_SCAN_RECORDS = 64;
+
+class SoakTest {
+public:
+    // Take the restored state as the starting point, call once before the main loop
+    void begin(const PomodoroContext& ctx);
+
+    // Keys for this frame, call once per frame before InputEvents::fill().
+    // Returns the live keys if there are any, otherwise the scripted ones
+    KeyInput frame(const PomodoroContext& ctx, KeyInput live);
+
+    // Assert the state machine invariants, call after the timer and link
+    // updates and before SessionHistory::update() takes the finished interval
+    void check(const PomodoroContext& ctx);
+
+    // Compare the SRAM records with the finished interval and log the report
+    // when it is due, call after SessionHistory and SaveStore updates
+    void checkSaved(const PomodoroContext& ctx, const SessionHistory& history);
+
+private:
+    uint32_t _random = 0x50534F4B;          // xorshift32 state
+    int _waitFrames = 0;                    // Frames until the next scripted key
+
+    // Values seen on the previous check
+    int _completedSessions = 0;
+    int _completedSets = 0;
+    uint32_t _clockSeconds = 0;
+
+    uint32_t _startClock = 0;
+    uint32_t _reportClock = 0;
+    bn::optional<SessionRecord> _finished;  // Ended this frame, checked against SRAM
+    int _records = 0;
+    bool _scanned = false;                  // The last frame decoded the history, don't sample its CPU usage
+
+    bn::fixed _peakCpu;
+    int _peakSprites = 0;
+    int _peakTiles = 0;
+    int _peakTileItems = 0;
+    int _lowFreeTiles = 0;
+
+    // Random value in [0, range)
+    int random(int range);
+
+    // Scripted key for the current state, or 0
+    uint16_t scriptedKey(const PomodoroContext& ctx);
+
+    void sample();
+    void report(const PomodoroContext& ctx);
+};
+
+#else
+
+class SoakTest {
+public:
+    void begin(const PomodoroContext&) {
+    }
+
+    KeyInput frame(const PomodoroContext&, KeyInput live) {
+        return live;
+    }
+
+    void check(const PomodoroContext&) {
+    }
+
+    void checkSaved(const PomodoroContext&, const SessionHistory&) {
+    }
+};
+
+#endif
+
+#endif
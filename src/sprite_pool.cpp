@@ -0,0 +1,105 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Sprite pool implementation
+ */
+#include "sprite_pool.h"
+
+#include "bn_assert.h"
+#include "bn_sprite_tiles.h"
+
+#include "perf_hud.h"
+
+bool SpritePool::canAcquire(int count, int tiles, SpritePriority priority) const {
+    const SpriteReserve& reserve = SPRITE_RESERVES[static_cast<int>(priority)];
+    
+    return SPRITE_POOL_SLOTS - _usedCount - count >= reserve.slots &&
+           bn::sprite_tiles::available_tiles_count() - tiles >= reserve.tiles;
+}
+
+SpriteHandle SpritePool::acquire(int x, int y, const bn::sprite_shape_size& shapeSize,
+                                 const bn::sprite_tiles_ptr& tiles, const bn::sprite_palette_ptr& palette,
+                                 SpritePriority priority) {
+    // The tiles are already allocated by the caller
+    if (!canAcquire(1, 0, priority)) {
+        BN_ASSERT(priority != SpritePriority::ESSENTIAL, "Sprite pool is full");
+        
+        ++_refusedCount;
+        perf::countSpriteRefusal();
+        return SPRITE_HANDLE_NONE;
+    }
+    
+    SpriteHandle handle = findFree();
+    
+    if (handle < _sprites.size()) {
+        // Reuse a hidden sprite, rewriting it in place
+        bn::sprite_ptr& sprite = _sprites[handle];
+        sprite.set_tiles(tiles, shapeSize);
+        sprite.set_palette(palette);
+        sprite.set_position(x, y);
+        sprite.set_visible(true);
+    } else {
+        _sprites.push_back(bn::sprite_ptr::create(x, y, shapeSize, tiles, palette));
+    }
+    
+    _used[handle] = true;
+    ++_usedCount;
+    perf::noteSpriteUsage(_usedCount);
+    return handle;
+}
+
+SpriteHandle SpritePool::acquire(const bn::sprite_ptr& source, SpritePriority priority) {
+    return acquire(source.x().integer(), source.y().integer(), source.shape_size(), source.tiles(),
+                   source.palette(), priority);
+}
+
+void SpritePool::assign(SpriteHandle handle, const bn::sprite_ptr& source) {
+    bn::sprite_ptr& sprite = this->sprite(handle);
+    sprite.set_tiles(source.tiles(), source.shape_size());
+    sprite.set_palette(source.palette());
+    sprite.set_position(source.x(), source.y());
+}
+
+void SpritePool::setTiles(SpriteHandle handle, const bn::sprite_tiles_ptr& tiles) {
+    sprite(handle).set_tiles(tiles);
+}
+
+void SpritePool::setTiles(SpriteHandle handle, const bn::sprite_tiles_ptr& tiles,
+                          const bn::sprite_shape_size& shapeSize) {
+    sprite(handle).set_tiles(tiles, shapeSize);
+}
+
+void SpritePool::setPosition(SpriteHandle handle, int x, int y) {
+    sprite(handle).set_position(x, y);
+}
+
+void SpritePool::setPalette(SpriteHandle handle, const bn::sprite_palette_ptr& palette) {
+    sprite(handle).set_palette(palette);
+}
+
+void SpritePool::setVisible(SpriteHandle handle, bool visible) {
+    sprite(handle).set_visible(visible);
+}
+
+void SpritePool::release(SpriteHandle handle) {
+    // The sprite and its tiles are kept; the next acquire rewrites them
+    sprite(handle).set_visible(false);
+    _used[handle] = false;
+    --_usedCount;
+}
+
+bn::sprite_ptr& SpritePool::sprite(SpriteHandle handle) {
+    BN_ASSERT(handle >= 0 && handle < _sprites.size() && _used[handle], "Invalid sprite handle: ", handle);
+    
+    return _sprites[handle];
+}
+
+SpriteHandle SpritePool::findFree() const {
+    for (SpriteHandle handle = 0; handle < _sprites.size(); ++handle) {
+        if (!_used[handle]) {
+            return handle;
+        }
+    }
+    
+    // No hidden sprite left: the next slot is created
+    return _sprites.size();
+}
@@ -0,0 +1,110 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Persistent pool of sprite handles. Slots are handed out by index and
+ * rewritten in place; released slots are hidden instead of destroyed, so the
+ * sprite allocator is only touched when the pool grows.
+ *
+ * The pool also keeps the sprite budget: each client states a priority, and
+ * lower priorities must leave headroom in pool slots and sprite tile VRAM for
+ * higher ones. A refused element is dropped (or drawn on the BG text layer by
+ * its owner) instead of overflowing the pool.
+ */
+#ifndef POMI_SPRITE_POOL_H
+#define POMI_SPRITE_POOL_H
+
+#include "bn_vector.h"
+#include "bn_sprite_ptr.h"
+#include "bn_sprite_tiles_ptr.h"
+#include "bn_sprite_palette_ptr.h"
+#include "bn_sprite_shape_size.h"
+
+// Maximum sprites the pool can own (labels, countdown and overlays together)
+constexpr int SPRITE_POOL_SLOTS = 32;
+
+// Index of a pool slot
+using SpriteHandle = int;
+
+// Handle of an acquire that was refused by the budget
+constexpr SpriteHandle SPRITE_HANDLE_NONE = -1;
+
+// Importance of a pool client; when the budget runs short, lower priorities are refused first
+enum class SpritePriority {
+    DECORATION,     // Cosmetic, simply dropped
+    HINT,           // Labels and hints, their owner can fall back to BG text
+    ESSENTIAL       // The countdown, granted as long as space remains at all
+};
+
+// Slots and sprite tiles a priority must leave free for the ones above it
+struct SpriteReserve {
+    int slots;
+    int tiles;
+};
+
+constexpr SpriteReserve SPRITE_RESERVES[] = {
+    { 8, 64 },      // DECORATION
+    { 5, 32 },      // HINT: room for a countdown
+    { 0, 0 }        // ESSENTIAL
+};
+
+class SpritePool {
+public:
+    SpritePool() = default;
+
+    SpritePool(const SpritePool&) = delete;
+    SpritePool& operator=(const SpritePool&) = delete;
+
+    // Returns true if count more sprites using the given number of new tiles
+    // fit the budget of the priority. Hidden slots keep their tiles until
+    // reused, so the tile check errs on the safe side
+    [[nodiscard]] bool canAcquire(int count, int tiles, SpritePriority priority) const;
+
+    // Take a slot showing the given tiles at (x, y). Hidden slots are reused
+    // before a new sprite is created. Returns SPRITE_HANDLE_NONE if the budget
+    // refuses it; essential sprites assert instead
+    [[nodiscard]] SpriteHandle acquire(int x, int y, const bn::sprite_shape_size& shapeSize,
+                                       const bn::sprite_tiles_ptr& tiles, const bn::sprite_palette_ptr& palette,
+                                       SpritePriority priority = SpritePriority::ESSENTIAL);
+
+    // Take a slot that copies the position, shape, tiles and palette of another sprite
+    [[nodiscard]] SpriteHandle acquire(const bn::sprite_ptr& source,
+                                       SpritePriority priority = SpritePriority::ESSENTIAL);
+
+    // Copy the position, shape, tiles and palette of another sprite into a slot
+    void assign(SpriteHandle handle, const bn::sprite_ptr& source);
+
+    void setTiles(SpriteHandle handle, const bn::sprite_tiles_ptr& tiles);
+    void setTiles(SpriteHandle handle, const bn::sprite_tiles_ptr& tiles, const bn::sprite_shape_size& shapeSize);
+    void setPosition(SpriteHandle handle, int x, int y);
+    void setPalette(SpriteHandle handle, const bn::sprite_palette_ptr& palette);
+    void setVisible(SpriteHandle handle, bool visible);
+
+    // Hide the slot and make it available to the next acquire
+    void release(SpriteHandle handle);
+
+    [[nodiscard]] bn::sprite_ptr& sprite(SpriteHandle handle);
+
+    // Slots currently handed out
+    [[nodiscard]] int usedCount() const {
+        return _usedCount;
+    }
+
+    // Sprites created so far (high-water mark of the pool)
+    [[nodiscard]] int createdCount() const {
+        return _sprites.size();
+    }
+
+    // Acquires refused by the budget so far
+    [[nodiscard]] int refusedCount() const {
+        return _refusedCount;
+    }
+
+private:
+    bn::vector<bn::sprite_ptr, SPRITE_POOL_SLOTS> _sprites;
+    bool _used[SPRITE_POOL_SLOTS] = {};
+    int _usedCount = 0;
+    int _refusedCount = 0;
+
+    [[nodiscard]] SpriteHandle findFree() const;
+};
+
+#endif
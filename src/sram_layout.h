@@ -0,0 +1,29 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * SRAM map shared by the persistent stores.
+ */
+#ifndef POMI_SRAM_LAYOUT_H
+#define POMI_SRAM_LAYOUT_H
+
+#include "platform.h"
+
+constexpr int SRAM_SIZE = 32 * 1024;
+
+// Config and counters save block, two alternating slots
+constexpr int SAVE_SLOTS_OFFSET = 0;
+constexpr int SAVE_SLOTS = 2;
+constexpr int SAVE_SLOT_MAX_SIZE = 128;
+
+// Input trace at the end of SRAM, only in input trace builds (their history
+// ring is shorter, see input_trace.h)
+constexpr int INPUT_TRACE_MAX_SIZE = POMI_INPUT_RECORD || POMI_INPUT_REPLAY ? 4 * 1024 : 0;
+constexpr int INPUT_TRACE_OFFSET = SRAM_SIZE - INPUT_TRACE_MAX_SIZE;
+
+// Session history ring buffer: two alternating headers, then the record bytes
+constexpr int HISTORY_HEADERS_OFFSET = SAVE_SLOTS_OFFSET + SAVE_SLOTS * SAVE_SLOT_MAX_SIZE;
+constexpr int HISTORY_HEADERS = 2;
+constexpr int HISTORY_HEADER_MAX_SIZE = 32;
+constexpr int HISTORY_DATA_OFFSET = HISTORY_HEADERS_OFFSET + HISTORY_HEADERS * HISTORY_HEADER_MAX_SIZE;
+constexpr int HISTORY_CAPACITY = INPUT_TRACE_OFFSET - HISTORY_DATA_OFFSET;
+
+#endif
@@ -0,0 +1,96 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * State theming implementation
+ */
+#include "state_theme.h"
+
+#include "bg_text.h"
+
+namespace {
+    // Ease-out fade weights out of 32, one entry per update
+    constexpr int FADE_WEIGHTS[] = { 6, 12, 17, 22, 26, 29, 31, 32 };
+    constexpr int FADE_STEPS = sizeof(FADE_WEIGHTS) / sizeof(FADE_WEIGHTS[0]);
+    
+    constexpr int blendChannel(int from, int to, int weight) {
+        return from + ((to - from) * weight) / 32;
+    }
+    
+    constexpr bn::color blend(bn::color from, bn::color to, int weight) {
+        return bn::color(blendChannel(from.red(), to.red(), weight),
+                         blendChannel(from.green(), to.green(), weight),
+                         blendChannel(from.blue(), to.blue(), weight));
+    }
+    
+    // Scale the accent by the brightness of a font palette entry, keeping the
+    // glyph shading and outlines
+    constexpr bn::color tint(bn::color base, bn::color accent) {
+        int brightness = base.red();
+        
+        if (base.green() > brightness) {
+            brightness = base.green();
+        }
+        
+        if (base.blue() > brightness) {
+            brightness = base.blue();
+        }
+        
+        return bn::color((accent.red() * brightness) / 31,
+                         (accent.green() * brightness) / 31,
+                         (accent.blue() * brightness) / 31);
+    }
+}
+
+StateTheme::StateTheme(const bn::sprite_palette_item& fontPalette, bn::color accent) :
+    _spritePalette(bn::sprite_palette_ptr::create_new(fontPalette)),
+    _from(accent),
+    _to(accent),
+    _fadeStep(FADE_STEPS) {
+    bn::span<const bn::color> colors = fontPalette.colors_ref();
+    
+    for (int index = 0; index < 16; ++index) {
+        _baseColors[index] = colors[index];
+    }
+}
+
+void StateTheme::setAccent(bn::color accent, bool fade) {
+    if (accent == _to) {
+        return;
+    }
+    
+    if (fade && _fadeStep < FADE_STEPS) {
+        // Start from wherever the current fade has reached
+        _from = blend(_from, _to, FADE_WEIGHTS[_fadeStep]);
+    } else {
+        _from = _to;
+    }
+    
+    _to = accent;
+    _fadeStep = fade ? 0 : FADE_STEPS;
+    _dirty = true;
+}
+
+void StateTheme::update(BgText& bgText) {
+    if (_fadeStep < FADE_STEPS) {
+        apply(blend(_from, _to, FADE_WEIGHTS[_fadeStep]), bgText);
+        ++_fadeStep;
+        _dirty = false;
+    } else if (_dirty) {
+        apply(_to, bgText);
+        _dirty = false;
+    }
+}
+
+bool StateTheme::fading() const {
+    return _fadeStep < FADE_STEPS || _dirty;
+}
+
+void StateTheme::apply(bn::color accent, BgText& bgText) {
+    _spriteColors[0] = _baseColors[0];
+    
+    for (int index = 1; index < 16; ++index) {
+        _spriteColors[index] = tint(_baseColors[index], accent);
+    }
+    
+    _spritePalette.set_colors(_spriteColors);
+    bgText.setAccentColor(accent);
+}
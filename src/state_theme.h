@@ -0,0 +1,48 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * State theming through palette entries.
+ *
+ * Accent text references a reserved palette slot (the accent slot of the BG
+ * text layer and a tinted copy of the sprite font palette), so a theme change
+ * is a few palette writes with no sprite or tile regeneration.
+ */
+#ifndef POMI_STATE_THEME_H
+#define POMI_STATE_THEME_H
+
+#include "bn_color.h"
+#include "bn_sprite_palette_ptr.h"
+#include "bn_sprite_palette_item.h"
+
+class BgText;
+
+class StateTheme {
+public:
+    StateTheme(const bn::sprite_palette_item& fontPalette, bn::color accent);
+
+    // Palette shared by accent colored sprites
+    [[nodiscard]] const bn::sprite_palette_ptr& spritePalette() const {
+        return _spritePalette;
+    }
+
+    // Change the accent color, optionally fading to it over a few frames
+    void setAccent(bn::color accent, bool fade = true);
+
+    // Write pending palette changes, call once per rendered frame
+    void update(BgText& bgText);
+
+    // True while a fade has steps left
+    [[nodiscard]] bool fading() const;
+
+private:
+    bn::color _baseColors[16];
+    bn::color _spriteColors[16];
+    bn::sprite_palette_ptr _spritePalette;
+    bn::color _from;
+    bn::color _to;
+    int _fadeStep;
+    bool _dirty = true;
+
+    void apply(bn::color accent, BgText& bgText);
+};
+
+#endif
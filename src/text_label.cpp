@@ -0,0 +1,150 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Retained text element implementation
+ */
+#include "text_label.h"
+
+#include "bg_text.h"
+#include "perf_hud.h"
+
+TextLabel::TextLabel(SpritePool& pool, int x, int y, const bn::string_view& text, SpritePriority priority) :
+    _pool(pool),
+    _text(text),
+    _x(x),
+    _y(y),
+    _priority(priority) {
+}
+
+TextLabel::~TextLabel() {
+    releaseFrom(0);
+}
+
+void TextLabel::setText(const bn::string_view& text) {
+    if (bn::string_view(_text) == text) {
+        return;
+    }
+
+    _text = text;
+    _dirty = true;
+}
+
+void TextLabel::setPalette(const bn::sprite_palette_ptr& palette) {
+    _palette = palette;
+    _dirty = true;
+}
+
+void TextLabel::setPosition(int x, int y) {
+    int dx = x - _x;
+    int dy = y - _y;
+
+    if (dx == 0 && dy == 0) {
+        return;
+    }
+
+    _x = x;
+    _y = y;
+
+    if (fallbackShown()) {
+        _dirty = true;
+    }
+
+    for (SpriteHandle handle : _handles) {
+        bn::sprite_ptr& sprite = _pool.sprite(handle);
+        sprite.set_position(sprite.x() + dx, sprite.y() + dy);
+    }
+}
+
+void TextLabel::release() {
+    releaseFrom(0);
+    clearFallback();
+
+    // Inputs must be re-evaluated when the label comes back on screen
+    _key.invalidate();
+    _dirty = true;
+}
+
+bool TextLabel::refresh(bn::sprite_text_generator& text_generator) {
+    if (!_dirty) {
+        return false;
+    }
+
+    _dirty = false;
+
+    if (_text.empty()) {
+        releaseFrom(0);
+        clearFallback();
+        return false;
+    }
+
+    // Ask the budget before generating: the generator's temporary sprites
+    // need new tiles even when the label's slots are reused
+    int sprites = (text_generator.width(_text) + LABEL_SPRITE_WIDTH - 1) / LABEL_SPRITE_WIDTH;
+    int newSprites = sprites > _handles.size() ? sprites - _handles.size() : 0;
+
+    if (sprites > LABEL_MAX_SPRITES || !_pool.canAcquire(newSprites, sprites * LABEL_SPRITE_TILES, _priority)) {
+        showFallback();
+        return true;
+    }
+
+    // The generator allocates fresh sprites; only their tiles are kept, written
+    // into the label's pool slots. The temporary sprites are freed on return
+    bn::vector<bn::sprite_ptr, LABEL_MAX_SPRITES> generated;
+    text_generator.generate(_x, _y, _text, generated);
+    perf::countGenerate();
+    perf::noteSpriteUsage(_pool.usedCount());
+    
+    int index = 0;
+    
+    for (const bn::sprite_ptr& sprite : generated) {
+        if (index < _handles.size()) {
+            _pool.assign(_handles[index], sprite);
+        } else {
+            SpriteHandle handle = _pool.acquire(sprite, _priority);
+            
+            if (handle == SPRITE_HANDLE_NONE) {
+                showFallback();
+                return true;
+            }
+            
+            _handles.push_back(handle);
+        }
+        
+        if (_palette) {
+            _pool.setPalette(_handles[index], *_palette);
+        }
+        
+        ++index;
+    }
+    
+    releaseFrom(index);
+    clearFallback();
+    return true;
+}
+
+void TextLabel::showFallback() {
+    releaseFrom(0);
+    clearFallback();
+    
+    if (!_fallback) {
+        return;
+    }
+    
+    _fallbackCells = _text.size();
+    _fallbackColumn = BgText::columnAt(_x) - _fallbackCells / 2;
+    _fallbackRow = BgText::rowAt(_y);
+    _fallback->write(_fallbackColumn, _fallbackRow, _text);
+}
+
+void TextLabel::clearFallback() {
+    if (_fallbackCells) {
+        _fallback->fill(_fallbackColumn, _fallbackRow, _fallbackCells, ' ');
+        _fallbackCells = 0;
+    }
+}
+
+void TextLabel::releaseFrom(int index) {
+    while (_handles.size() > index) {
+        _pool.release(_handles.back());
+        _handles.pop_back();
+    }
+}
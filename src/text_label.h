@@ -0,0 +1,96 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Retained text element: owns slots of a sprite pool and only regenerates
+ * their tiles when its text or inputs change. When the pool budget refuses
+ * its sprites, the text goes to the BG text layer instead (if a fallback is
+ * set) or is not shown.
+ */
+#ifndef POMI_TEXT_LABEL_H
+#define POMI_TEXT_LABEL_H
+
+#include "bn_string.h"
+#include "bn_string_view.h"
+#include "bn_vector.h"
+#include "bn_optional.h"
+#include "bn_sprite_palette_ptr.h"
+#include "bn_sprite_text_generator.h"
+
+#include "change_key.h"
+#include "sprite_pool.h"
+
+class BgText;
+
+// Maximum sprites a single label can own (enough for a full-width line)
+constexpr int LABEL_MAX_SPRITES = 16;
+
+// The generator splits 8x16 text into 32x16 sprites of 8 tiles each
+constexpr int LABEL_SPRITE_WIDTH = 32;
+constexpr int LABEL_SPRITE_TILES = 8;
+
+class TextLabel {
+public:
+    TextLabel(SpritePool& pool, int x, int y, const bn::string_view& text = bn::string_view(),
+              SpritePriority priority = SpritePriority::HINT);
+    ~TextLabel();
+
+    TextLabel(const TextLabel&) = delete;
+    TextLabel& operator=(const TextLabel&) = delete;
+
+    // Version stamp check: returns true (and stores the key) if the inputs
+    // the label is built from differ from the last call
+    bool changed(int key) {
+        return _key.changed(key);
+    }
+
+    // Set the text; the label is only marked dirty if the text differs
+    void setText(const bn::string_view& text);
+
+    // Use the given palette instead of the generator's one (e.g. a theme palette)
+    void setPalette(const bn::sprite_palette_ptr& palette);
+
+    // Write the text centered on the BG text layer while the budget refuses its sprites
+    void setFallback(BgText& bgText) {
+        _fallback = &bgText;
+    }
+
+    // Move the label, shifting existing sprites instead of regenerating them
+    void setPosition(int x, int y);
+
+    // Hand the sprites back to the pool but keep the text, so the next refresh rebuilds them
+    void release();
+
+    // Regenerate the sprites if dirty. Returns true if anything was generated
+    bool refresh(bn::sprite_text_generator& text_generator);
+
+    [[nodiscard]] int spritesCount() const {
+        return _handles.size();
+    }
+
+    // True while the text is shown on the BG text layer instead of sprites
+    [[nodiscard]] bool fallbackShown() const {
+        return _fallbackCells > 0;
+    }
+
+private:
+    SpritePool& _pool;
+    bn::vector<SpriteHandle, LABEL_MAX_SPRITES> _handles;
+    bn::optional<bn::sprite_palette_ptr> _palette;
+    bn::string<32> _text;
+    BgText* _fallback = nullptr;
+    int _x;
+    int _y;
+    int _fallbackColumn = 0;
+    int _fallbackRow = 0;
+    int _fallbackCells = 0;         // BG cells written by the fallback
+    SpritePriority _priority;
+    ChangeKey _key;
+    bool _dirty = true;
+
+    void releaseFrom(int index);
+
+    // Drop the sprites and write the text on the fallback layer, if any
+    void showFallback();
+    void clearFallback();
+};
+
+#endif
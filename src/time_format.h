@@ -0,0 +1,76 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Compile-time number tables for clock and config text.
+ */
+#ifndef POMI_TIME_FORMAT_H
+#define POMI_TIME_FORMAT_H
+
+#include "bn_assert.h"
+#include "bn_string.h"
+#include "bn_string_view.h"
+
+#include "clock_time.h"
+
+class NumberLabels {
+public:
+    static constexpr int COUNT = 100;
+
+    // Labels for 0..99, zero-padded to two digits or not, followed by an optional suffix
+    constexpr NumberLabels(bool padded, char suffix) {
+        for (int value = 0; value < COUNT; ++value) {
+            char* text = _text[value];
+            int length = 0;
+
+            if (padded || value >= 10) {
+                text[length++] = char('0' + value / 10);
+            }
+
+            text[length++] = char('0' + value % 10);
+
+            if (suffix) {
+                text[length++] = suffix;
+            }
+
+            _length[value] = length;
+        }
+    }
+
+    bn::string_view operator[](int value) const {
+        BN_ASSERT(value >= 0 && value < COUNT, "Invalid label value: ", value);
+
+        return bn::string_view(_text[value], _length[value]);
+    }
+
+private:
+    char _text[COUNT][4] = {};
+    int _length[COUNT] = {};
+};
+
+// "00".."99"
+constexpr NumberLabels TWO_DIGITS(true, '\0');
+
+// "0".."99"
+constexpr NumberLabels COUNT_LABELS(false, '\0');
+
+// "0m".."99m"
+constexpr NumberLabels MINUTE_LABELS(false, 'm');
+
+// Format seconds as MM:SS, clamped to 00:00..99:59
+inline bn::string<8> formatClock(int seconds) {
+    if (seconds < 0) {
+        seconds = 0;
+    } else if (seconds > MAX_CLOCK_SECONDS) {
+        seconds = MAX_CLOCK_SECONDS;
+    }
+
+    ClockTime clock = splitClock(seconds);
+    bn::string<8> text = TWO_DIGITS[clock.minutes];
+    text.push_back(':');
+    text.append(TWO_DIGITS[clock.seconds]);
+    return text;
+}
+
+static_assert(splitClock(MAX_CLOCK_SECONDS).minutes == 99 && splitClock(MAX_CLOCK_SECONDS).seconds == 59);
+static_assert(splitClock(60).minutes == 1 && splitClock(59).minutes == 0);
+
+#endif
@@ -0,0 +1,94 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Drift-free tick-to-seconds conversion.
+ *
+ * Tick deltas are computed with wrap-safe 32-bit arithmetic and the
+ * sub-second remainder is carried between updates, so no time is lost when
+ * whole seconds are consumed. The ticks per second rate is a compile-time
+ * constant: power of two rates divide with a shift, other rates with the
+ * multiply-by-reciprocal sequence the compiler emits for constant divisors.
+ */
+#ifndef POMI_TIMEBASE_H
+#define POMI_TIMEBASE_H
+
+template<unsigned TicksPerSecond>
+class Timebase {
+    // The upper bound keeps the remainder scaling in remainderFraction() within 32 bits
+    static_assert(TicksPerSecond > 0 && TicksPerSecond <= (1u << 20), "Invalid ticks per second");
+
+public:
+    static constexpr unsigned ticksPerSecond = TicksPerSecond;
+
+    // Resume counting from the given tick count, keeping the carried remainder
+    void start(unsigned nowTicks) {
+        _lastTicks = nowTicks;
+    }
+
+    // Restart counting from the given tick count, discarding the remainder
+    // (or starting from the given one)
+    void reset(unsigned nowTicks, unsigned remainder = 0) {
+        _lastTicks = nowTicks;
+        _remainder = remainder;
+    }
+
+    // Move the remainder by a signed tick count without going below zero, so
+    // the count runs a little ahead or behind. Returns the ticks applied
+    int slew(int ticks) {
+        if (ticks < 0 && unsigned(-ticks) > _remainder) {
+            ticks = -static_cast<int>(_remainder);
+        }
+
+        _remainder += static_cast<unsigned>(ticks);
+        return ticks;
+    }
+
+    // Consume elapsed ticks and return the number of whole seconds that passed.
+    // Valid as long as it is called at least once per 2^32 ticks.
+    [[nodiscard]] int advance(unsigned nowTicks) {
+        unsigned elapsed = (nowTicks - _lastTicks) + _remainder;
+        _lastTicks = nowTicks;
+
+        unsigned seconds = divide(elapsed);
+        _remainder = elapsed - seconds * TicksPerSecond;
+        return static_cast<int>(seconds);
+    }
+
+    // Ticks accumulated towards the next whole second
+    [[nodiscard]] unsigned remainderTicks() const {
+        return _remainder;
+    }
+
+    // Progress towards the next whole second in 1/4096 units, [0, 4096)
+    [[nodiscard]] int remainderFraction() const {
+        return static_cast<int>(divide(_remainder << 12));
+    }
+
+    // Milliseconds left when secondsRemaining whole seconds are still to elapse
+    [[nodiscard]] int millisecondsRemaining(int secondsRemaining) const {
+        return secondsRemaining * 1000 - static_cast<int>(divide(_remainder * 1000));
+    }
+
+private:
+    unsigned _lastTicks = 0;
+    unsigned _remainder = 0;
+
+    static constexpr unsigned divide(unsigned ticks) {
+        if constexpr ((TicksPerSecond & (TicksPerSecond - 1)) == 0) {
+            return ticks >> shift();
+        } else {
+            return ticks / TicksPerSecond;
+        }
+    }
+
+    static constexpr int shift() {
+        int result = 0;
+
+        while ((1u << result) < TicksPerSecond) {
+            ++result;
+        }
+
+        return result;
+    }
+};
+
+#endif
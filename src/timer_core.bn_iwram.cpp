@@ -0,0 +1,9 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Timer core placed in IWRAM as ARM code (POMI_IWRAM_CORE)
+ */
+#include "code_placement.h"
+
+#if POMI_IWRAM_CORE
+    #include "timer_core_impl.h"
+#endif
@@ -0,0 +1,9 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Timer core kept in ROM as Thumb code (POMI_IWRAM_CORE=0)
+ */
+#include "code_placement.h"
+
+#if !POMI_IWRAM_CORE
+    #include "timer_core_impl.h"
+#endif
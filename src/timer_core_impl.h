@@ -0,0 +1,303 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Timer update and input dispatch. Included by timer_core.bn_iwram.cpp or
+ * timer_core.cpp depending on POMI_IWRAM_CORE.
+ */
+#ifndef POMI_TIMER_CORE_IMPL_H
+#define POMI_TIMER_CORE_IMPL_H
+
+#include "pomodoro_core.h"
+
+namespace {
+    bool timedState(PomodoroState state) {
+        return state == PomodoroState::WORK || state == PomodoroState::SHORT_BREAK ||
+               state == PomodoroState::LONG_BREAK;
+    }
+    
+    // Hand the running interval over to the session history
+    void finishSession(PomodoroContext& ctx, bool reset) {
+        if (!ctx.sessionStarted) {
+            return;
+        }
+        
+        SessionRecord record;
+        record.state = ctx.state;
+        record.startTime = ctx.sessionStart;
+        record.plannedSeconds = stateDuration(ctx);
+        record.actualSeconds = static_cast<int>(ctx.clockSeconds - ctx.sessionStart);
+        record.focusSeconds = record.plannedSeconds - ctx.secondsRemaining;
+        record.pauses = ctx.sessionPauses;
+        record.paused = ctx.sessionPauses > 0;
+        record.reset = reset;
+        ctx.finishedSession = record;
+        ctx.sessionStarted = false;
+        
+        // Running aggregates are updated here, the statistics screen never scans the history
+        ctx.stats.add(record, sessionDay(ctx.clockSeconds));
+    }
+    
+    // Count down, handling the end of the interval. The timer stops when an
+    // interval ends, so this crosses at most one state transition
+    void advanceTimer(PomodoroContext& ctx, int elapsedSeconds) {
+        // Decrease the remaining time
+        ctx.secondsRemaining -= elapsedSeconds;
+        
+        // Check if timer has ended
+        if (ctx.secondsRemaining <= 0) {
+            // Timer finished
+            ctx.timerActive = false;
+            ctx.secondsRemaining = 0;
+            
+            // Play sound to alert user
+            playSound(SoundId::TIMER_END);
+            finishSession(ctx, false);
+            
+            // Switch to next state
+            // If we're in a work session, track completion
+            if (ctx.state == PomodoroState::WORK) {
+                ctx.completedSessions++;
+                
+                // Check if we've completed a full set
+                if (ctx.completedSessions % ctx.config.sessionsPerSet == 0) {
+                    ctx.completedSets++;
+                    changeState(ctx, PomodoroState::LONG_BREAK);
+                } else {
+                    changeState(ctx, PomodoroState::SHORT_BREAK);
+                }
+            } else if (ctx.state == PomodoroState::SHORT_BREAK || 
+                     ctx.state == PomodoroState::LONG_BREAK) {
+                // After a break, go back to work
+                changeState(ctx, PomodoroState::WORK);
+            }
+        }
+    }
+    
+    // Config menu items, values in menu units (minutes or sessions)
+    struct ConfigItem {
+        int PomodoroConfig::* field;
+        int unit;
+        int max;
+    };
+    
+    constexpr ConfigItem CONFIG_ITEMS[] = {
+        { &PomodoroConfig::workTime, 60, MAX_CONFIG_MINUTES },
+        { &PomodoroConfig::shortBreakTime, 60, MAX_CONFIG_MINUTES },
+        { &PomodoroConfig::longBreakTime, 60, MAX_CONFIG_MINUTES },
+        { &PomodoroConfig::sessionsPerSet, 1, MAX_CONFIG_SESSIONS }
+    };
+    
+    constexpr int CONFIG_ITEMS_COUNT = sizeof(CONFIG_ITEMS) / sizeof(CONFIG_ITEMS[0]);
+    
+    // Adjustments of the selected value within a frame, written back once
+    class ConfigEdit {
+    public:
+        // Move the value by one step; accelerated steps land on multiples of the step
+        void step(PomodoroContext& ctx, int direction, int step) {
+            const ConfigItem& item = CONFIG_ITEMS[ctx.configSelection];
+            
+            if (!_pending) {
+                _pending = true;
+                _value = ctx.config.*item.field / item.unit;
+            }
+            
+            if (step > 1) {
+                _value = direction > 0 ? (_value / step + 1) * step : ((_value + step - 1) / step - 1) * step;
+            } else {
+                _value += direction;
+            }
+            
+            _value = _value < 1 ? 1 : _value > item.max ? item.max : _value;
+        }
+        
+        // Write the pending value into the config
+        void apply(PomodoroContext& ctx) {
+            if (_pending) {
+                const ConfigItem& item = CONFIG_ITEMS[ctx.configSelection];
+                ctx.config.*item.field = _value * item.unit;
+                _pending = false;
+            }
+        }
+        
+    private:
+        int _value = 0;
+        bool _pending = false;
+    };
+    
+    // A key press on the timer screen
+    void handleTimerKey(PomodoroContext& ctx, uint16_t key) {
+        // In a link cable group the leader starts, pauses and resets the timers
+        bool follower = ctx.groupRole == GroupRole::FOLLOWER;
+        
+        // Toggle timer
+        if (key == KeyInput::A && !follower) {
+            // Standby has no interval of its own, starting from it begins a work interval
+            if (ctx.state == PomodoroState::IDLE) {
+                changeState(ctx, PomodoroState::WORK);
+            }
+            
+            setTimerActive(ctx, !ctx.timerActive);
+        }
+        
+        // Reset timer
+        if (key == KeyInput::B && !follower) {
+            finishSession(ctx, true);
+            ctx.timerActive = false;
+            // Reset the tick counter, dropping any partial second
+            ctx.timebase.reset(ctx.timer.elapsed_ticks());
+            
+            // Reset to appropriate duration based on current state
+            ctx.secondsRemaining = stateDuration(ctx);
+        }
+        
+        // Enter config mode
+        if (key == KeyInput::SELECT) {
+            finishSession(ctx, true);
+            ctx.timerActive = false;
+            changeState(ctx, PomodoroState::CONFIG);
+        }
+    }
+}
+
+// Update the timer state, returns true if a second boundary was crossed
+bool updateTimer(PomodoroContext& ctx) {
+    // The session clock runs whether or not the timer does
+    ctx.clockSeconds += ctx.clock.advance(ctx.timer.elapsed_ticks());
+    
+    // Only update if timer is active
+    if (!ctx.timerActive) {
+        return false;
+    }
+    
+#if POMI_HW_SECONDS
+    // Seconds are counted by the cascaded hardware timers
+    int elapsedSeconds = ctx.seconds.poll();
+#else
+    // Whole seconds elapsed, the sub-second remainder is carried over
+    int elapsedSeconds = ctx.timebase.advance(ctx.timer.elapsed_ticks());
+#endif
+    
+    if (elapsedSeconds > 0) {
+        advanceTimer(ctx, elapsedSeconds);
+    }
+    
+    return elapsedSeconds > 0;
+}
+
+// Resume the running interval: ctx.secondsRemaining holds the value saved at
+// the checkpoint and ctx.clockSeconds the current wall clock time
+void resumeTimer(PomodoroContext& ctx, uint32_t deadline) {
+    ctx.timerActive = true;
+    ctx.timebase.reset(ctx.timer.elapsed_ticks());
+#if POMI_HW_SECONDS
+    ctx.seconds.restart();
+#endif
+    
+    uint32_t now = ctx.clockSeconds;
+    int remaining = deadline > now ? static_cast<int>(deadline - now) : 0;
+    int elapsedSeconds = ctx.secondsRemaining - remaining;
+    
+    if (elapsedSeconds <= 0) {
+        return;
+    }
+    
+    // A missed end is recorded at its deadline, not at the time of the resume
+    if (remaining == 0) {
+        ctx.clockSeconds = deadline;
+    }
+    
+    advanceTimer(ctx, elapsedSeconds);
+    ctx.clockSeconds = now;
+}
+
+// Start or pause the timer
+void setTimerActive(PomodoroContext& ctx, bool active) {
+    if (active == ctx.timerActive) {
+        return;
+    }
+    
+    ctx.timerActive = active;
+    
+    // If starting timer, resume counting from now
+    if (ctx.timerActive) {
+        ctx.timebase.start(ctx.timer.elapsed_ticks());
+#if POMI_HW_SECONDS
+        ctx.seconds.restart();
+#endif
+        
+        // The first start opens a new interval in the history
+        if (!ctx.sessionStarted && timedState(ctx.state)) {
+            ctx.sessionStarted = true;
+            ctx.sessionPauses = 0;
+            ctx.sessionStart = ctx.clockSeconds;
+        }
+    } else if (ctx.sessionStarted) {
+        ++ctx.sessionPauses;
+    }
+}
+
+// Move to the state of another timer. An interval about to end locally ends
+// normally, so a follower a few frames behind its leader still records it as
+// finished; any other interval is recorded as reset
+void followState(PomodoroContext& ctx, PomodoroState state) {
+    if (state == ctx.state) {
+        return;
+    }
+    
+    if (ctx.timerActive && ctx.secondsRemaining <= 1) {
+        advanceTimer(ctx, ctx.secondsRemaining);
+    }
+    
+    if (state != ctx.state) {
+        finishSession(ctx, true);
+        changeState(ctx, state);
+    }
+}
+
+// Handle the queued input events, returns true if there were any. Adjustments
+// of the selected config value are applied once, after the last of them
+bool handleInput(PomodoroContext& ctx, InputEvents& events) {
+    // Nothing to dispatch on most frames
+    if (events.empty()) {
+        return false;
+    }
+    
+    ConfigEdit edit;
+    InputEvent event;
+    
+    while (events.pop(event)) {
+        if (ctx.state == PomodoroState::CONFIG) {
+            // Configuration mode input handling
+            if (event.key == KeyInput::LEFT || event.key == KeyInput::RIGHT) {
+                edit.step(ctx, event.key == KeyInput::RIGHT ? 1 : -1, event.step);
+                continue;
+            }
+            
+            edit.apply(ctx);
+            
+            // Navigate configuration options, wrapping around the 4 items
+            if (event.key == KeyInput::UP) {
+                ctx.configSelection = ctx.configSelection > 0 ? ctx.configSelection - 1 : CONFIG_ITEMS_COUNT - 1;
+            } else if (event.key == KeyInput::DOWN) {
+                ctx.configSelection = ctx.configSelection < CONFIG_ITEMS_COUNT - 1 ? ctx.configSelection + 1 : 0;
+            } else if (event.key == KeyInput::START) {
+                // Open the statistics screen
+                changeState(ctx, PomodoroState::STATS);
+            } else if (event.key == KeyInput::B || event.key == KeyInput::SELECT) {
+                // Exit config mode
+                changeState(ctx, PomodoroState::IDLE);
+            }
+        } else if (ctx.state == PomodoroState::STATS) {
+            // Back to the config menu
+            if (event.key == KeyInput::B || event.key == KeyInput::START || event.key == KeyInput::SELECT) {
+                changeState(ctx, PomodoroState::CONFIG);
+            }
+        } else if (!event.repeat) {
+            handleTimerKey(ctx, event.key);
+        }
+    }
+    
+    edit.apply(ctx);
+    return true;
+}
+
+#endif
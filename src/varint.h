@@ -0,0 +1,42 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Variable-length integers for the compact SRAM and trace formats.
+ */
+#ifndef POMI_VARINT_H
+#define POMI_VARINT_H
+
+#include <cstdint>
+
+// Largest encoded 32-bit value
+constexpr int VARINT_MAX_BYTES = 5;
+
+// LEB128: 7 bits per byte, high bit set on all but the last byte
+inline int putVarint(uint8_t* output, uint32_t value) {
+    int size = 0;
+
+    while (value >= 0x80) {
+        output[size++] = static_cast<uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+
+    output[size++] = static_cast<uint8_t>(value);
+    return size;
+}
+
+// Decode the varint at position, advancing it. Returns false if it runs past size
+inline bool getVarint(const uint8_t* input, int size, int& position, uint32_t& value) {
+    value = 0;
+
+    for (int shift = 0; shift < VARINT_MAX_BYTES * 7 && position < size; shift += 7) {
+        uint8_t byte = input[position++];
+        value |= uint32_t(byte & 0x7F) << shift;
+
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+#endif
@@ -0,0 +1,65 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Wall clock implementation
+ */
+#include "wall_clock.h"
+
+#if POMI_RTC
+    #include "bn_date.h"
+    #include "bn_time.h"
+    #include "bn_config_rtc.h"
+
+    static_assert(BN_CFG_RTC_ENABLED, "POMI_RTC builds need -DBN_CFG_RTC_ENABLED=true, or the RTC is never read");
+#endif
+
+namespace {
+    // Days before the first of each month in a non-leap year
+    constexpr int MONTH_START_DAYS[12] = { 0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334 };
+
+    // Days since 2000-01-01. The RTC stores 2000-2099, where every fourth year is a leap year
+    [[maybe_unused]] constexpr uint32_t daysSince2000(int year, int month, int monthDay) {
+        int days = year * 365 + (year + 3) / 4 + MONTH_START_DAYS[month - 1] + monthDay - 1;
+
+        if (month > 2 && year % 4 == 0) {
+            ++days;
+        }
+
+        return static_cast<uint32_t>(days);
+    }
+
+    static_assert(daysSince2000(0, 1, 1) == 0);
+    static_assert(daysSince2000(0, 3, 1) == 60);
+    static_assert(daysSince2000(1, 1, 1) == 366);
+    static_assert(daysSince2000(24, 1, 1) == 8766);
+}
+
+bool readWallClock(uint32_t& seconds) {
+#if POMI_RTC
+    bn::optional<bn::date> date = bn::date::current();
+    bn::optional<bn::time> time = bn::time::current();
+
+    if (!date || !time) {
+        return false;
+    }
+
+    seconds = daysSince2000(date->year(), date->month(), date->month_day()) * SECONDS_PER_DAY +
+              static_cast<uint32_t>(time->hour() * 60 * 60 + time->minute() * 60 + time->second());
+    return true;
+#else
+    (void) seconds;
+    return false;
+#endif
+}
+
+bool syncWallClock(PomodoroContext& ctx) {
+    uint32_t seconds;
+
+    if (!readWallClock(seconds)) {
+        return false;
+    }
+
+    ctx.clockSeconds = seconds;
+    ctx.clock.reset(ctx.timer.elapsed_ticks());
+    ctx.wallClock = true;
+    return true;
+}
@@ -0,0 +1,31 @@
+/*
+ * Pomi - A GBA Pomodoro Timer
+ * Optional cartridge RTC wall clock.
+ *
+ * bn::timer stops while the console sleeps or is off. With an RTC the
+ * session clock follows the wall clock instead, so a running interval can be
+ * resumed from its saved deadline with one clock read. Enable it by adding
+ * -DPOMI_RTC=1 -DBN_CFG_RTC_ENABLED=true to USERFLAGS (Butano only reads the
+ * RTC with the latter); carts without an RTC fall back to the uptime session
+ * clock.
+ */
+#ifndef POMI_WALL_CLOCK_H
+#define POMI_WALL_CLOCK_H
+
+#include <cstdint>
+
+#include "pomodoro_core.h"
+
+#ifndef POMI_RTC
+    #define POMI_RTC 0
+#endif
+
+// Read the RTC as seconds since 2000-01-01 00:00. Returns false if there is
+// no RTC or POMI_RTC is disabled
+[[nodiscard]] bool readWallClock(uint32_t& seconds);
+
+// Restart the session clock from the RTC. Returns false (leaving the clock
+// as it is) without one
+bool syncWallClock(PomodoroContext& ctx);
+
+#endif